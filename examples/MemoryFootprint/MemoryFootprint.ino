@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// (C) 2023 Dirk Hillbrecht
+
+// Memory footprint: Report how much RAM the UiUiUi classes and an example interface need
+
+// This sketch does not need a display. It prints on the serial console
+//
+// - the size of each UiUiUi class on the architecture it is compiled for and
+// - the total size of the interface of the MockWeatherStation example.
+//
+// Compile and run it for each of your target boards (e.g. an AVR-based Arduino Uno
+// and an ESP32) to see the differences between 8-bit and 32-bit architectures.
+//
+// The sketch also shows how to make the build fail if an interface exceeds a memory budget.
+
+
+// **************************
+// *** Include statements ***
+// **************************
+
+// You need the U8g2 library
+#include <U8g2lib.h>
+
+// And we load the complete UiUiUi library with the combining header file
+#include <UiUiUi.h>
+
+
+// ***************************
+// *** Example interface ***
+// ***************************
+
+// This is the interface of the MockWeatherStation example. It is never rendered.
+
+UITextLine statusTextLine=UITextLine(u8g2_font_6x10_tf,UIAlignment::CenterLeft);
+UIHorizontalLine horizontalLine=UIHorizontalLine(&statusTextLine);
+UITextIcon btIcon=UITextIcon(u8g2_font_streamline_interface_essential_circle_triangle_t,UISize(23,23));
+UITextIcon wlanIcon=UITextIcon(u8g2_font_streamline_interface_essential_wifi_t,UISize(23,23),&btIcon);
+UIRows iconsGroup=UIRows(&wlanIcon);
+UIEnvelope iconsEnvelope=UIEnvelope(UIExpansion::Vertical,UIAlignment::Center,&iconsGroup);
+UIVerticalLine verticalLine=UIVerticalLine(&iconsEnvelope);
+UITextLine largeTextLine2=UITextLine(u8g2_font_crox3cb_tf);
+UITextLine largeTextLine1=UITextLine(u8g2_font_crox3cb_tf,true,&largeTextLine2);
+UIRows largeTextScreen=UIRows(&largeTextLine1);
+UITextLine smallTextLine3=UITextLine(u8g2_font_6x10_tf,UIAlignment::CenterLeft);
+UITextLine smallTextLine2=UITextLine(u8g2_font_6x10_tf,UIAlignment::CenterLeft,&smallTextLine3);
+UITextLine smallTextLine1=UITextLine(u8g2_font_6x10_tf,UIAlignment::CenterLeft,true,&smallTextLine2);
+UIRows smallTextScreen=UIRows(&smallTextLine1,&largeTextScreen);
+UICards mainScreens=UICards(&smallTextScreen);
+UIEnvelope mainEnvelope=UIEnvelope(UIExpansion::Both,UIAlignment::Center,&mainScreens,&verticalLine);
+UIColumns topColumns=UIColumns(&mainEnvelope,&horizontalLine);
+UIRows fullScreen=UIRows(&topColumns);
+UIDisplay weatherDisplay=UIDisplay(&fullScreen);
+
+// The budget check: Compilation fails if the interface needs more than 2 KB.
+// Lower the number to see it fail, or use it with your own interface and budget.
+UIUIUI_FOOTPRINT_BUDGET(2048,
+  statusTextLine,horizontalLine,btIcon,wlanIcon,iconsGroup,iconsEnvelope,verticalLine,
+  largeTextLine2,largeTextLine1,largeTextScreen,smallTextLine3,smallTextLine2,smallTextLine1,
+  smallTextScreen,mainScreens,mainEnvelope,topColumns,fullScreen,weatherDisplay);
+
+
+// ********************
+// *** Report ***
+// ********************
+
+// Print one line of the report
+void report(const char* label,size_t bytes) {
+  Serial.print(label);
+  Serial.print(": ");
+  Serial.print(bytes);
+  Serial.println(" bytes");
+}
+
+void setup() {
+  Serial.begin(115200);
+  Serial.println("UiUiUi memory footprint");
+  Serial.print("Pointer size: ");Serial.println(sizeof(void*));
+
+  Serial.println("Helper classes:");
+  report("UIPoint",sizeof(UIPoint));
+  report("UISize",sizeof(UISize));
+  report("UIArea",sizeof(UIArea));
+  report("UIAreaList",sizeof(UIAreaList));
+
+  Serial.println("Widgets:");
+  report("UITextLine",sizeof(UITextLine));
+  report("UITextIcon",sizeof(UITextIcon));
+  report("UIBitmap",sizeof(UIBitmap));
+  report("UIFlashBitmap",sizeof(UIFlashBitmap));
+  report("UIHorizontalLine",sizeof(UIHorizontalLine));
+  report("UIVerticalLine",sizeof(UIVerticalLine));
+  report("UICheckerboard",sizeof(UICheckerboard));
+  report("UIEnvelope",sizeof(UIEnvelope));
+
+  Serial.println("Widget groups:");
+  report("UIWidgetGroup",sizeof(UIWidgetGroup));
+  report("UIRows",sizeof(UIRows));
+  report("UIColumns",sizeof(UIColumns));
+  report("UICards",sizeof(UICards));
+  report("UIStaticRows<10,10>",sizeof(UIStaticRows<10,10>));
+
+  Serial.println("Display:");
+  report("UIDisplay",sizeof(UIDisplay));
+
+  Serial.println("MockWeatherStation interface:");
+  report("Total",UIFootprint::of(
+    statusTextLine,horizontalLine,btIcon,wlanIcon,iconsGroup,iconsEnvelope,verticalLine,
+    largeTextLine2,largeTextLine1,largeTextScreen,smallTextLine3,smallTextLine2,smallTextLine1,
+    smallTextScreen,mainScreens,mainEnvelope,topColumns,fullScreen,weatherDisplay));
+  Serial.print("Text width cache entries: ");Serial.println(UIUIUI_TEXT_WIDTH_CACHE_SIZE);
+}
+
+/* Loop function: Nothing to be done here. */
+void loop() {
+  delay(1000);
+}
+
+// end of file
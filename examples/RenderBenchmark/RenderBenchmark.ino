@@ -0,0 +1,313 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// (C) 2023 Dirk Hillbrecht
+
+// Benchmark: Measure rendering time and display traffic of some example interfaces
+
+// This sketch does not need a display at all. It runs UiUiUi on top of a U8g2 instance
+// with a full frame buffer whose communication callbacks do not talk to any hardware,
+// but only count what _would_ have been sent to the display.
+//
+// It builds the interfaces of the HelloWorld, CheckerboardAndButtons and MockWeatherStation
+// examples and a small clock interface which sends its tiles with a UISimulatedTransfer
+// and renders changes during a transfer into a back buffer,
+// renders the MockWeatherStation interface once more on a display with a page buffer,
+// runs the typical updates of these examples and reports on the serial console
+//
+// - the time needed for layouting and for rendering,
+// - the number of tiles sent to the display, and
+// - the number of bytes which would have been transferred over the bus.
+//
+// Run this sketch before and after changes to UiUiUi or to your own widgets
+// to see whether rendering became slower or sends more data than before.
+// As no display is attached, the timings contain only the CPU work of UiUiUi and U8g2,
+// not the time the bytes need on the wire.
+
+
+// **************************
+// *** Include statements ***
+// **************************
+
+// You need the U8g2 library
+#include <U8g2lib.h>
+
+// And we load the complete UiUiUi library with the combining header file
+#include <UiUiUi.h>
+
+
+// ***********************************
+// *** Display without any hardware ***
+// ***********************************
+
+// Counters for the display traffic
+unsigned long busBytes,tilesSent,tileTransfers;
+
+// Original display callback of the SSD1306 driver, called by the counting callback
+u8x8_msg_cb ssd1306DisplayCallback;
+
+// Byte callback: Counts the bytes which would be sent over the bus and discards them.
+uint8_t countingByteCallback(u8x8_t *u8x8,uint8_t msg,uint8_t arg_int,void *arg_ptr) {
+  if (msg==U8X8_MSG_BYTE_SEND)
+    busBytes+=arg_int;
+  return 1;
+}
+
+// Display callback: Counts the tiles sent to the display and passes everything to the actual driver.
+uint8_t countingDisplayCallback(u8x8_t *u8x8,uint8_t msg,uint8_t arg_int,void *arg_ptr) {
+  if (msg==U8X8_MSG_DISPLAY_DRAW_TILE) {
+    tilesSent+=((u8x8_tile_t*)arg_ptr)->cnt*arg_int;
+    tileTransfers++;
+  }
+  return ssd1306DisplayCallback(u8x8,msg,arg_int,arg_ptr);
+}
+
+// Setup function of U8g2 for a display, they differ in the size of the frame buffer
+typedef void (*U8g2SetupFunction)(u8g2_t *u8g2,const u8g2_cb_t *rotation,u8x8_msg_cb byte_cb,u8x8_msg_cb gpio_and_delay_cb);
+
+// An SSD1306 128x64 display, but without any hardware access.
+class U8G2_BENCHMARK: public U8G2 {
+  public:
+    U8G2_BENCHMARK(U8g2SetupFunction setupFunction,const u8g2_cb_t *rotation): U8G2() {
+      setupFunction(&u8g2,rotation,countingByteCallback,u8x8_dummy_cb);
+      ssd1306DisplayCallback=u8g2.u8x8.display_cb;
+      u8g2.u8x8.display_cb=countingDisplayCallback;
+    }
+};
+
+// The display with full frame buffer, used by most measurements
+U8G2_BENCHMARK u8g2(u8g2_Setup_ssd1306_128x64_noname_f,U8G2_R0);
+
+// The same display with a page buffer of two tile rows, UIDisplay renders and sends it page by page
+U8G2_BENCHMARK u8g2Pages(u8g2_Setup_ssd1306_128x64_noname_2,U8G2_R0);
+
+// The U8g2 instance the measurements render on
+U8G2 *screen=&u8g2;
+
+
+// *** HelloWorld interface ***
+
+UITextLine helloTextLine=UITextLine(u8g2_font_6x10_tf);
+UIDisplay helloDisplay=UIDisplay(&helloTextLine);
+
+// Checksums of all 128 tiles, unchanged tiles are not sent once they are enabled
+uint16_t helloChecksums[128];
+
+
+// *** CheckerboardAndButtons interface ***
+
+UICheckerboard checkerboard=UICheckerboard();
+UICards checkerboardCard=UICards(&checkerboard);
+UIDisplay checkerboardDisplay=UIDisplay(&checkerboardCard);
+
+
+// *** MockWeatherStation interface ***
+
+UITextLine statusTextLine=UITextLine(u8g2_font_6x10_tf,UIAlignment::CenterLeft);
+UIHorizontalLine horizontalLine=UIHorizontalLine(&statusTextLine);
+UITextIcon btIcon=UITextIcon(u8g2_font_streamline_interface_essential_circle_triangle_t,UISize(23,23));
+UITextIcon wlanIcon=UITextIcon(u8g2_font_streamline_interface_essential_wifi_t,UISize(23,23),&btIcon);
+UIRows iconsGroup=UIRows(&wlanIcon);
+UIEnvelope iconsEnvelope=UIEnvelope(UIExpansion::Vertical,UIAlignment::Center,&iconsGroup);
+UIVerticalLine verticalLine=UIVerticalLine(&iconsEnvelope);
+UITextLine largeTextLine2=UITextLine(u8g2_font_crox3cb_tf);
+UITextLine largeTextLine1=UITextLine(u8g2_font_crox3cb_tf,true,&largeTextLine2);
+UIRows largeTextScreen=UIRows(&largeTextLine1);
+UITextLine smallTextLine3=UITextLine(u8g2_font_6x10_tf,UIAlignment::CenterLeft);
+UITextLine smallTextLine2=UITextLine(u8g2_font_6x10_tf,UIAlignment::CenterLeft,&smallTextLine3);
+UITextLine smallTextLine1=UITextLine(u8g2_font_6x10_tf,UIAlignment::CenterLeft,true,&smallTextLine2);
+UIRows smallTextScreen=UIRows(&smallTextLine1,&largeTextScreen);
+UICards mainScreens=UICards(&smallTextScreen);
+UIEnvelope mainEnvelope=UIEnvelope(UIExpansion::Both,UIAlignment::Center,&mainScreens,&verticalLine);
+UIColumns topColumns=UIColumns(&mainEnvelope,&horizontalLine);
+UIRows fullScreen=UIRows(&topColumns);
+UIDisplay weatherDisplay=UIDisplay(&fullScreen);
+
+
+// *** Clock interface with non-blocking transfer ***
+
+// Each tile needs 1 ms, so render() calls right after a change find the transfer still running.
+UISimulatedTransfer simulatedTransfer=UISimulatedTransfer(1000);
+
+// Changes during a transfer are rendered into this buffer meanwhile
+uint8_t clockBackBuffer[1024];
+
+// Checksums of all 128 tiles, with a transfer each run of changed tiles is sent separately
+uint16_t clockChecksums[128];
+
+UITextLine dayTextLine=UITextLine(u8g2_font_6x10_tf);
+UITextLine timeTextLine=UITextLine(u8g2_font_crox3cb_tf);
+UIEnvelope timeEnvelope=UIEnvelope(UIExpansion::Vertical,UIAlignment::Center,&timeTextLine,&dayTextLine);
+UIRows clockRows=UIRows(&timeEnvelope);
+UIDisplay clockDisplay=UIDisplay(&clockRows);
+
+
+// *********************
+// *** Measurements ***
+// *********************
+
+// Start time of the current measurement
+unsigned long startMicros;
+
+// Start a measurement: Reset counters and remember the start time
+void startMeasurement() {
+  busBytes=0;tilesSent=0;tileTransfers=0;
+  startMicros=micros();
+}
+
+// Finish a measurement and print its result in one line
+void reportMeasurement(const char* label) {
+  unsigned long duration=micros()-startMicros;
+  Serial.print(label);
+  Serial.print(": ");Serial.print(duration);Serial.print(" us, ");
+  Serial.print(tilesSent);Serial.print(" tiles in ");
+  Serial.print(tileTransfers);Serial.print(" transfers, ");
+  Serial.print(busBytes);Serial.println(" bus bytes");
+}
+
+// Render the given display until all tiles have been sent and report the result.
+void measureRender(const char* label,UIDisplay* display,bool force=false) {
+  startMeasurement();
+  display->render(screen,force);
+  while (display->isUpdatingDisplay(screen))
+    display->render(screen);
+  reportMeasurement(label);
+}
+
+// Render the given display and change the text line while the tiles of the first change are still transferred.
+void measureChangeDuringTransfer(const char* label,UIDisplay* display,UITextLine* line,const char* text) {
+  startMeasurement();
+  display->render(screen);
+  line->setText(text);
+  display->render(screen);
+  while (display->isUpdatingDisplay(screen))
+    display->render(screen);
+  reportMeasurement(label);
+}
+
+// Render the given display and request a forced rendering while its tiles are still transferred.
+void measureForceDuringTransfer(const char* label,UIDisplay* display) {
+  startMeasurement();
+  display->render(screen);
+  display->render(screen,true);
+  while (display->isUpdatingDisplay(screen))
+    display->render(screen);
+  reportMeasurement(label);
+}
+
+// Layout the given display without rendering it and report the result.
+void measureInit(const char* label,UIDisplay* display) {
+  startMeasurement();
+  display->init(screen,true,false);
+  reportMeasurement(label);
+}
+
+void benchmarkHelloWorld() {
+  helloTextLine.setText("Hello World");
+  measureInit("HelloWorld layout",&helloDisplay);
+  measureRender("HelloWorld forced render",&helloDisplay,true);
+  helloTextLine.setText("Hello UiUiUi");
+  measureRender("HelloWorld text change",&helloDisplay);
+  helloDisplay.setTileChecksums(helloChecksums,sizeof(helloChecksums)/sizeof(helloChecksums[0]));
+  measureRender("HelloWorld checksums forced render",&helloDisplay,true);
+  helloTextLine.updateText();
+  measureRender("HelloWorld checksums same text",&helloDisplay);
+  helloTextLine.setText("Hello World!");
+  measureRender("HelloWorld checksums text change",&helloDisplay);
+}
+
+void benchmarkCheckerboard() {
+  measureInit("Checkerboard layout",&checkerboardDisplay);
+  measureRender("Checkerboard forced render",&checkerboardDisplay,true);
+  checkerboardCard.showFirstWidget();
+  measureRender("Checkerboard show",&checkerboardDisplay);
+  checkerboardCard.hide();
+  measureRender("Checkerboard hide",&checkerboardDisplay);
+}
+
+void benchmarkWeatherStation() {
+  measureInit("MockWeatherStation layout",&weatherDisplay);
+  measureRender("MockWeatherStation forced render",&weatherDisplay,true);
+  mainScreens.setVisibleWidget(&smallTextScreen);
+  smallTextLine1.setText("Temp.:    27 °C");
+  smallTextLine2.setText("Humidity: 75 %");
+  smallTextLine3.setText("Wind:      3 Bft");
+  measureRender("MockWeatherStation card switch",&weatherDisplay);
+  smallTextLine1.setText("Temp.:    28 °C");
+  measureRender("MockWeatherStation one value",&weatherDisplay);
+  statusTextLine.setText("Connecting WLAN");
+  wlanIcon.setText("0");
+  measureRender("MockWeatherStation status and icon",&weatherDisplay);
+  weatherDisplay.setUpdateTiles(6,20);
+  statusTextLine.setText("Conn. Bluetooth");
+  btIcon.setText("5");
+  measureRender("MockWeatherStation restricted tiles",&weatherDisplay);
+  weatherDisplay.setUpdateTiles();
+}
+
+void benchmarkTransfer() {
+  clockDisplay.setTransfer(&simulatedTransfer);
+  clockDisplay.setBackBuffer(clockBackBuffer,sizeof(clockBackBuffer));
+  timeTextLine.setText("12:00");
+  dayTextLine.setText("Monday");
+  measureInit("Transfer layout",&clockDisplay);
+  measureRender("Transfer forced render",&clockDisplay,true);
+  timeTextLine.setText("12:01");
+  measureRender("Transfer time",&clockDisplay);
+  timeTextLine.setText("12:02");
+  dayTextLine.setText("Tuesday");
+  measureRender("Transfer time and day",&clockDisplay);
+  timeTextLine.setText("12:03");
+  measureForceDuringTransfer("Transfer forced during transfer",&clockDisplay);
+  timeTextLine.setText("12:04");
+  measureChangeDuringTransfer("Transfer other line during transfer",&clockDisplay,&dayTextLine,"Wednesday");
+  timeTextLine.setText("12:05");
+  measureChangeDuringTransfer("Transfer same line during transfer",&clockDisplay,&timeTextLine,"12:06");
+  clockDisplay.setTileChecksums(clockChecksums,sizeof(clockChecksums)/sizeof(clockChecksums[0]));
+  measureRender("Transfer checksums forced render",&clockDisplay,true);
+  timeTextLine.updateText();
+  measureRender("Transfer checksums same text",&clockDisplay);
+  timeTextLine.setText("12:07");
+  measureRender("Transfer checksums time",&clockDisplay);
+}
+
+void benchmarkPages() {
+  screen=&u8g2Pages;
+  measureInit("Page buffer layout",&weatherDisplay);
+  measureRender("Page buffer forced render",&weatherDisplay,true);
+  mainScreens.setVisibleWidget(&largeTextScreen);
+  largeTextLine1.setText("27 °C");
+  largeTextLine2.setText("75 %");
+  measureRender("Page buffer card switch",&weatherDisplay);
+  mainScreens.setVisibleWidget(&smallTextScreen);
+  measureRender("Page buffer card switch back",&weatherDisplay);
+  smallTextLine2.setText("Humidity: 76 %");
+  measureRender("Page buffer one value",&weatherDisplay);
+  smallTextLine2.setMinUpdateInterval(60000);
+  smallTextLine2.setText("Humidity: 77 %");
+  smallTextLine1.setText("Temp.:    29 °C");
+  measureRender("Page buffer deferred line on a rendered page",&weatherDisplay);
+  smallTextLine2.setText("Humidity: 78 %");
+  statusTextLine.setText("Connected");
+  measureRender("Page buffer deferred line on another page",&weatherDisplay);
+  smallTextLine2.setMinUpdateInterval();
+  screen=&u8g2;
+}
+
+void setup() {
+  Serial.begin(115200);
+  u8g2.begin();
+  u8g2Pages.begin();
+  Serial.println("UiUiUi render benchmark");
+  benchmarkHelloWorld();
+  benchmarkCheckerboard();
+  benchmarkWeatherStation();
+  benchmarkTransfer();
+  benchmarkPages();
+  Serial.println("Benchmark finished");
+}
+
+/* Loop function: Nothing to be done here. */
+void loop() {
+  delay(1000);
+}
+
+// end of file
@@ -0,0 +1,36 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// (C) 2023 Dirk Hillbrecht
+
+#include <chrono>
+#include <thread>
+
+#include "Arduino.h"
+
+HardwareSerial Serial;
+
+static const std::chrono::steady_clock::time_point programStart=std::chrono::steady_clock::now();
+
+// Time returned after setFakeMillis() has been called
+static bool fakeTime=false;
+static unsigned long fakeMicros;
+
+unsigned long micros() {
+  if (fakeTime)
+    return fakeMicros;
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now()-programStart).count();
+}
+
+unsigned long millis() {
+  return micros()/1000;
+}
+
+void setFakeMillis(unsigned long ms) {
+  fakeTime=true;
+  fakeMicros=ms*1000;
+}
+
+void delay(unsigned long ms) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+// end of file
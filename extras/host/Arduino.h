@@ -0,0 +1,67 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// (C) 2023 Dirk Hillbrecht
+
+// Minimal Arduino environment for building UiUiUi, its benchmark and the widget checks on a Linux host
+//
+// Only what UiUiUi and the host programs need is here. Serial writes to stdout,
+// micros() and millis() count from the program start or return a fake time, PROGMEM is ordinary memory.
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+
+using std::min;
+using std::max;
+
+#define PROGMEM
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#define pgm_read_ptr(addr) (*(void* const*)(addr))
+#define memcpy_P memcpy
+
+#define LOW 0
+#define HIGH 1
+
+/** Microseconds since the program start. */
+unsigned long micros();
+
+/** Milliseconds since the program start. */
+unsigned long millis();
+
+/** Let millis() and micros() return the given time from now on, it only changes with further calls. For checks of timing behaviour. */
+void setFakeMillis(unsigned long ms);
+
+/** Sleep for the given number of milliseconds. */
+void delay(unsigned long ms);
+
+/** Serial console on stdout, numbers are printed in decimal like on the Arduino. */
+class HardwareSerial {
+
+  public:
+
+    void begin(unsigned long baud) {}
+
+    size_t print(const char* text) { return printf("%s",text); }
+    size_t print(char c) { return printf("%c",c); }
+    size_t print(int value) { return printf("%d",value); }
+    size_t print(unsigned int value) { return printf("%u",value); }
+    size_t print(long value) { return printf("%ld",value); }
+    size_t print(unsigned long value) { return printf("%lu",value); }
+    size_t print(double value) { return printf("%.2f",value); }
+
+    size_t println() { return printf("\n"); }
+
+    template<class T> size_t println(T value) {
+      size_t n=print(value);
+      return n+println();
+    }
+
+};
+
+extern HardwareSerial Serial;
+
+// end of file
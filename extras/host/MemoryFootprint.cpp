@@ -0,0 +1,19 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// (C) 2023 Dirk Hillbrecht
+
+// Runs the MemoryFootprint sketch once on the host
+//
+// The sketch checks the size of its interface with UIUIUI_FOOTPRINT_BUDGET(),
+// so it does not compile at all if the interface exceeds the budget.
+
+#include "Arduino.h"
+#include <U8g2lib.h>
+
+#include "../../examples/MemoryFootprint/MemoryFootprint.ino"
+
+int main() {
+  setup();
+  return 0;
+}
+
+// end of file
@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// (C) 2023 Dirk Hillbrecht
+
+// Checks of UIUpdateQueue with a UIThreadRenderWorker on the host
+//
+// Two producer threads post their texts into chained queues while the render worker renders.
+// Each producer writes every text into the same buffer and posts it with copyText(), so the
+// buffer is overwritten right after posting. In the end, the display must show the last texts
+// of both producers, exactly as a forced rendering of them. Built with UIUIUI_STD_THREAD=1.
+
+#include "Arduino.h"
+#include <U8g2lib.h>
+
+#include <UiUiUi.h>
+
+#include <thread>
+
+U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2(U8G2_R0);
+
+// Number of texts each producer posts
+static const int UPDATES=2000;
+
+UITextLine networkLine=UITextLine(u8g2_font_6x10_tf);
+UITextLine sensorLine=UITextLine(u8g2_font_6x10_tf,&networkLine);
+UIRows rows=UIRows(&sensorLine);
+UIDisplay display=UIDisplay(&rows);
+
+// One queue per producer, chained
+UIUpdateQueue networkQueue;
+UIUpdateQueue sensorQueue(&networkQueue);
+
+// Texts of the lines, only accessed by the rendering task
+char sensorText[UIUIUI_UPDATE_QUEUE_TEXT_SIZE];
+char networkText[UIUIUI_UPDATE_QUEUE_TEXT_SIZE];
+
+UIThreadRenderWorker worker;
+
+// Frame buffer content after the worker has rendered the last texts
+static uint8_t workerBuffer[1024];
+
+/* Post the numbered texts one after the other from the same buffer, retry while the queue is full. */
+void produce(UIUpdateQueue* queue,UITextLine* line,char* lineText,const char* format) {
+  char buffer[UIUIUI_UPDATE_QUEUE_TEXT_SIZE];
+  for (int i=0;i<UPDATES;i++) {
+    snprintf(buffer,sizeof(buffer),format,i);
+    while (!queue->copyText(line,lineText,buffer))
+      std::this_thread::yield();
+    memset(buffer,'#',sizeof(buffer)-1);  // the queue must have its own copy
+  }
+}
+
+int main() {
+  sensorLine.setText("Sensor");
+  networkLine.setText("Network");
+  display.setUpdateQueue(&sensorQueue);
+  display.init(&u8g2);
+  display.startRenderWorker(&u8g2,&worker);
+  std::thread sensor(produce,&sensorQueue,&sensorLine,sensorText,"Sensor %d");
+  std::thread network(produce,&networkQueue,&networkLine,networkText,"Network %d");
+  sensor.join();
+  network.join();
+  worker.stop();
+  display.render(&u8g2);  // rendering task from now on: apply what the worker has not seen anymore
+  printf("%d texts posted by each of 2 producers\n",UPDATES);
+  printf("  queues empty: %s\n",(sensorQueue.isEmpty()?"yes":"NO"));
+  memcpy(workerBuffer,u8g2.getBufferPtr(),sizeof(workerBuffer));
+  char lastSensorText[UIUIUI_UPDATE_QUEUE_TEXT_SIZE],lastNetworkText[UIUIUI_UPDATE_QUEUE_TEXT_SIZE];
+  snprintf(lastSensorText,sizeof(lastSensorText),"Sensor %d",UPDATES-1);
+  snprintf(lastNetworkText,sizeof(lastNetworkText),"Network %d",UPDATES-1);
+  sensorLine.setText(lastSensorText);
+  networkLine.setText(lastNetworkText);
+  display.render(&u8g2,true);
+  printf("  display shows the last texts: %s\n",(memcmp(workerBuffer,u8g2.getBufferPtr(),sizeof(workerBuffer))==0?"yes":"NO"));
+  return 0;
+}
+
+// end of file
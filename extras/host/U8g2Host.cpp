@@ -0,0 +1,310 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// (C) 2023 Dirk Hillbrecht
+
+#include "Arduino.h"
+#include "U8g2lib.h"
+
+const u8g2_cb_t u8g2_cb_r0={0},u8g2_cb_r1={1},u8g2_cb_r2={2},u8g2_cb_r3={3};
+
+// Advance width, height above the baseline, height below the baseline, pixels drawn beyond the advance width
+const uint8_t u8g2_font_6x10_tf[]={6,8,2,0};
+const uint8_t u8g2_font_crox3cb_tf[]={12,14,3,0};
+const uint8_t u8g2_font_helvBO10_tf[]={8,10,3,2};
+const uint8_t u8g2_font_streamline_interface_essential_circle_triangle_t[]={21,21,0,0};
+const uint8_t u8g2_font_streamline_interface_essential_wifi_t[]={21,21,0,0};
+
+U8g2HostUpdates u8g2HostUpdates={0,0,false};
+
+uint8_t u8g2HostScreen[1024];
+
+// Frame buffer of the full buffer setup, UiUiUi's back buffer may take its place
+static uint8_t fullBuffer[1024];
+
+// Page buffers of the setups with one and two tile rows
+static uint8_t pageBuffer1[128],pageBuffer2[256];
+
+// Flag whether tiles are sent by U8G2::updateDisplayArea(), which logs them itself
+static bool inUpdateDisplayArea=false;
+
+void u8g2_ll_hvline_vertical_top_lsb(u8g2_t *u8g2,u8g2_uint_t x,u8g2_uint_t y,u8g2_uint_t len,uint8_t dir) {}
+void u8g2_ll_hvline_horizontal_right_lsb(u8g2_t *u8g2,u8g2_uint_t x,u8g2_uint_t y,u8g2_uint_t len,uint8_t dir) {}
+
+uint8_t u8x8_dummy_cb(u8x8_t *u8x8,uint8_t msg,uint8_t arg_int,void *arg_ptr) {
+  return 1;
+}
+
+/* Tiles sent directly, e.g. by UIDisplay in page buffer mode, are logged here. */
+uint8_t u8x8_DrawTile(u8x8_t *u8x8,uint8_t x,uint8_t y,uint8_t cnt,uint8_t *tile_ptr) {
+  if (u8g2HostUpdates.log && !inUpdateDisplayArea)
+    printf("  u8x8_DrawTile(%u,%u,%u)\n",x,y,cnt);
+  u8x8_tile_t tile;
+  tile.tile_ptr=tile_ptr;
+  tile.cnt=cnt;
+  tile.x_pos=x;
+  tile.y_pos=y;
+  return u8x8->display_cb(u8x8,U8X8_MSG_DISPLAY_DRAW_TILE,1,&tile);
+}
+
+/* Like the SSD1306 driver: Set page and column address, then send the tile data. The display RAM is kept in u8g2HostScreen. */
+static uint8_t ssd1306DisplayCallback(u8x8_t *u8x8,uint8_t msg,uint8_t arg_int,void *arg_ptr) {
+  if (msg==U8X8_MSG_DISPLAY_DRAW_TILE) {
+    u8x8_tile_t *tile=(u8x8_tile_t*)arg_ptr;
+    for (uint8_t t=0;t<tile->cnt && tile->x_pos+t<16;t++)
+      memcpy(u8g2HostScreen+(tile->y_pos*16+tile->x_pos+t)*8,tile->tile_ptr+t*8,8);
+    uint8_t commands[3]={(uint8_t)(0xb0|tile->y_pos),(uint8_t)(0x10|(tile->x_pos*8)>>4),(uint8_t)((tile->x_pos*8)&15)};
+    u8x8->byte_cb(u8x8,U8X8_MSG_BYTE_SEND,sizeof(commands),commands);
+    for (uint8_t i=0;i<arg_int;i++)
+      for (uint8_t t=0;t<tile->cnt;t++)
+        u8x8->byte_cb(u8x8,U8X8_MSG_BYTE_SEND,8,tile->tile_ptr+t*8);
+  }
+  return 1;
+}
+
+/* Common part of all setups, they differ only in the frame buffer. */
+static void setupSSD1306(u8g2_t *u8g2,const u8g2_cb_t *rotation,u8x8_msg_cb byte_cb,u8x8_msg_cb gpio_and_delay_cb,uint8_t *buffer,uint8_t tileRows) {
+  static const u8x8_display_info_t displayInfo={16,8,128,64};
+  u8g2->u8x8.display_info=&displayInfo;
+  u8g2->u8x8.display_cb=ssd1306DisplayCallback;
+  u8g2->u8x8.byte_cb=byte_cb;
+  u8g2->u8x8.gpio_and_delay_cb=gpio_and_delay_cb;
+  u8g2->cb=rotation;
+  u8g2->ll_hvline=u8g2_ll_hvline_vertical_top_lsb;
+  u8g2->tile_buf_ptr=buffer;
+  u8g2->tile_buf_height=tileRows;
+  bool turned=(rotation->quarterTurns&1);
+  u8g2->width=(turned?displayInfo.pixel_height:displayInfo.pixel_width);
+  u8g2->height=(turned?displayInfo.pixel_width:displayInfo.pixel_height);
+  u8g2->font=u8g2_font_6x10_tf;
+  u8g2->draw_color=1;
+  u8g2_SetBufferCurrTileRow(u8g2,0);
+  u8g2->clip_x0=0;u8g2->clip_y0=0;
+  u8g2->clip_x1=0xffff;u8g2->clip_y1=0xffff;
+}
+
+void u8g2_Setup_ssd1306_128x64_noname_f(u8g2_t *u8g2,const u8g2_cb_t *rotation,u8x8_msg_cb byte_cb,u8x8_msg_cb gpio_and_delay_cb) {
+  setupSSD1306(u8g2,rotation,byte_cb,gpio_and_delay_cb,fullBuffer,8);
+}
+
+void u8g2_Setup_ssd1306_128x64_noname_1(u8g2_t *u8g2,const u8g2_cb_t *rotation,u8x8_msg_cb byte_cb,u8x8_msg_cb gpio_and_delay_cb) {
+  setupSSD1306(u8g2,rotation,byte_cb,gpio_and_delay_cb,pageBuffer1,1);
+}
+
+void u8g2_Setup_ssd1306_128x64_noname_2(u8g2_t *u8g2,const u8g2_cb_t *rotation,u8x8_msg_cb byte_cb,u8x8_msg_cb gpio_and_delay_cb) {
+  setupSSD1306(u8g2,rotation,byte_cb,gpio_and_delay_cb,pageBuffer2,2);
+}
+
+u8x8_t *u8g2_GetU8x8(u8g2_t *u8g2) {
+  return &u8g2->u8x8;
+}
+
+uint8_t *u8g2_GetBufferPtr(u8g2_t *u8g2) {
+  return u8g2->tile_buf_ptr;
+}
+
+/* The user window is the part of the display covered by the current page, in rotated coordinates. */
+void u8g2_SetBufferCurrTileRow(u8g2_t *u8g2,uint8_t row) {
+  u8g2->tile_curr_row=row;
+  const u8x8_display_info_t *info=u8g2->u8x8.display_info;
+  u8g2_uint_t y0=row*8;
+  u8g2_uint_t y1=min(y0+u8g2->tile_buf_height*8,(int)info->pixel_height);
+  switch (u8g2->cb->quarterTurns) {
+    case 0: u8g2->user_x0=0;u8g2->user_x1=info->pixel_width;u8g2->user_y0=y0;u8g2->user_y1=y1;break;
+    case 1: u8g2->user_x0=y0;u8g2->user_x1=y1;u8g2->user_y0=0;u8g2->user_y1=info->pixel_width;break;
+    case 2: u8g2->user_x0=0;u8g2->user_x1=info->pixel_width;u8g2->user_y0=info->pixel_height-y1;u8g2->user_y1=info->pixel_height-y0;break;
+    default: u8g2->user_x0=info->pixel_height-y1;u8g2->user_x1=info->pixel_height-y0;u8g2->user_y0=0;u8g2->user_y1=info->pixel_width;break;
+  }
+}
+
+int8_t u8g2_GetGlyphWidth(u8g2_t *u8g2,uint16_t requested_encoding) {
+  return u8g2->font[0];
+}
+
+U8G2::U8G2() {
+  memset(&u8g2,0,sizeof(u8g2));
+}
+
+void U8G2::clearBuffer() {
+  memset(u8g2.tile_buf_ptr,0,getBufferTileWidth()*8*u8g2.tile_buf_height);
+}
+
+void U8G2::sendBuffer() {
+  for (uint8_t row=0;row<u8g2.tile_buf_height && u8g2.tile_curr_row+row<u8g2.u8x8.display_info->tile_height;row++)
+    u8x8_DrawTile(&u8g2.u8x8,0,u8g2.tile_curr_row+row,getBufferTileWidth(),u8g2.tile_buf_ptr+row*getBufferTileWidth()*8);
+}
+
+void U8G2::firstPage() {
+  setBufferCurrTileRow(0);
+  clearBuffer();
+}
+
+uint8_t U8G2::nextPage() {
+  sendBuffer();
+  uint8_t row=u8g2.tile_curr_row+u8g2.tile_buf_height;
+  if (row>=u8g2.u8x8.display_info->tile_height) {
+    setBufferCurrTileRow(0);
+    return 0;
+  }
+  setBufferCurrTileRow(row);
+  clearBuffer();
+  return 1;
+}
+
+/* As in U8g2: Only with a full frame buffer, one u8x8_DrawTile() call per tile row. The log shows if the tiles come from another buffer. */
+void U8G2::updateDisplayArea(uint8_t tx,uint8_t ty,uint8_t tw,uint8_t th) {
+  const u8x8_display_info_t *info=u8g2.u8x8.display_info;
+  if (u8g2.tile_buf_height!=info->tile_height || tx>=info->tile_width || ty>=info->tile_height)
+    return;
+  tw=min((int)tw,info->tile_width-tx);
+  th=min((int)th,info->tile_height-ty);
+  u8g2HostUpdates.calls++;
+  u8g2HostUpdates.tiles+=tw*th;
+  if (u8g2HostUpdates.log)
+    printf("  updateDisplayArea(%u,%u,%u,%u)%s\n",tx,ty,tw,th,(u8g2.tile_buf_ptr==fullBuffer?"":" from other buffer"));
+  inUpdateDisplayArea=true;
+  for (uint8_t row=ty;row<ty+th;row++)
+    u8x8_DrawTile(&u8g2.u8x8,tx,row,tw,u8g2.tile_buf_ptr+(row*info->tile_width+tx)*8);
+  inUpdateDisplayArea=false;
+}
+
+void U8G2::setClipWindow(u8g2_uint_t x0,u8g2_uint_t y0,u8g2_uint_t x1,u8g2_uint_t y1) {
+  u8g2.clip_x0=x0;u8g2.clip_y0=y0;
+  u8g2.clip_x1=x1;u8g2.clip_y1=y1;
+}
+
+void U8G2::setMaxClipWindow() {
+  setClipWindow(0,0,0xffff,0xffff);
+}
+
+/* Clip, rotate into display coordinates, then set, clear or invert the bit in the current page. */
+void U8G2::drawPixel(u8g2_uint_t x,u8g2_uint_t y) {
+  if (x<u8g2.clip_x0 || x>=u8g2.clip_x1 || y<u8g2.clip_y0 || y>=u8g2.clip_y1 || x>=u8g2.width || y>=u8g2.height)
+    return;
+  const u8x8_display_info_t *info=u8g2.u8x8.display_info;
+  int px,py;
+  switch (u8g2.cb->quarterTurns) {
+    case 0: px=x;py=y;break;
+    case 1: px=info->pixel_width-1-y;py=x;break;
+    case 2: px=info->pixel_width-1-x;py=info->pixel_height-1-y;break;
+    default: px=y;py=info->pixel_height-1-x;break;
+  }
+  int row=py/8-u8g2.tile_curr_row;
+  if (row<0 || row>=u8g2.tile_buf_height)
+    return;
+  uint8_t *ptr=u8g2.tile_buf_ptr+row*info->tile_width*8+px;
+  uint8_t bit=1<<(py&7);
+  if (u8g2.draw_color==0)
+    *ptr&=~bit;
+  else if (u8g2.draw_color==1)
+    *ptr|=bit;
+  else
+    *ptr^=bit;
+}
+
+void U8G2::drawHLine(u8g2_uint_t x,u8g2_uint_t y,u8g2_uint_t w) {
+  for (u8g2_uint_t i=0;i<w;i++)
+    drawPixel(x+i,y);
+}
+
+void U8G2::drawVLine(u8g2_uint_t x,u8g2_uint_t y,u8g2_uint_t h) {
+  for (u8g2_uint_t i=0;i<h;i++)
+    drawPixel(x,y+i);
+}
+
+/* Bresenham, both end points included as in U8g2. */
+void U8G2::drawLine(u8g2_uint_t x1,u8g2_uint_t y1,u8g2_uint_t x2,u8g2_uint_t y2) {
+  int dx=abs((int)x2-(int)x1),dy=-abs((int)y2-(int)y1);
+  int sx=(x1<x2?1:-1),sy=(y1<y2?1:-1);
+  int error=dx+dy;
+  int x=x1,y=y1;
+  for (;;) {
+    drawPixel(x,y);
+    if (x==x2 && y==y2)
+      break;
+    int e2=2*error;
+    if (e2>=dy) {
+      error+=dy;
+      x+=sx;
+    }
+    if (e2<=dx) {
+      error+=dx;
+      y+=sy;
+    }
+  }
+}
+
+void U8G2::drawBox(u8g2_uint_t x,u8g2_uint_t y,u8g2_uint_t w,u8g2_uint_t h) {
+  for (u8g2_uint_t j=0;j<h;j++)
+    drawHLine(x,y+j,w);
+}
+
+void U8G2::drawFrame(u8g2_uint_t x,u8g2_uint_t y,u8g2_uint_t w,u8g2_uint_t h) {
+  if (w==0 || h==0)
+    return;
+  drawHLine(x,y,w);
+  drawHLine(x,y+h-1,w);
+  drawVLine(x,y,h);
+  drawVLine(x+w-1,y,h);
+}
+
+/* XBM: rows of bytes, least significant bit left. Unset pixels are drawn in the other color unless transparent. */
+void U8G2::drawXBM(u8g2_uint_t x,u8g2_uint_t y,u8g2_uint_t w,u8g2_uint_t h,const uint8_t *bitmap) {
+  uint8_t color=u8g2.draw_color;
+  u8g2_uint_t bytesPerRow=(w+7)/8;
+  for (u8g2_uint_t j=0;j<h;j++)
+    for (u8g2_uint_t i=0;i<w;i++) {
+      bool set=pgm_read_byte(bitmap+j*bytesPerRow+i/8)&(1<<(i&7));
+      if (!set && u8g2.bitmap_transparency)
+        continue;
+      u8g2.draw_color=(set?color:!color);
+      drawPixel(x+i,y+j);
+    }
+  u8g2.draw_color=color;
+}
+
+/* Length of the UTF-8 sequence starting with the given byte */
+static uint8_t utf8Length(uint8_t first) {
+  return (first<0x80?1:first<0xe0?2:first<0xf0?3:4);
+}
+
+/* As in U8g2, the width contains the pixels of the last glyph beyond its advance width. */
+u8g2_uint_t U8G2::getStrWidth(const char *s) {
+  return (*s?strlen(s)*u8g2.font[0]+u8g2.font[3]:0);
+}
+
+u8g2_uint_t U8G2::getUTF8Width(const char *s) {
+  u8g2_uint_t width=(*s?u8g2.font[3]:0);
+  for (;*s;s+=utf8Length(*s))
+    width+=u8g2.font[0];
+  return width;
+}
+
+/* No real glyphs: A pattern depending on the character fills the glyph box with the top at y, oblique fonts beyond the advance width. */
+u8g2_uint_t U8G2::drawGlyph(u8g2_uint_t x,u8g2_uint_t y,uint16_t encoding) {
+  uint8_t width=u8g2.font[0]+u8g2.font[3],height=u8g2.font[1]+u8g2.font[2];
+  for (uint8_t i=0;i+1<width;i++)
+    for (uint8_t j=0;j<height;j++)
+      if ((encoding*31+i*7+j*13)%5==0)
+        drawPixel(x+i,y+j);
+  return u8g2.font[0];
+}
+
+u8g2_uint_t U8G2::drawStr(u8g2_uint_t x,u8g2_uint_t y,const char *s) {
+  u8g2_uint_t start=x;
+  for (;*s;s++)
+    x+=drawGlyph(x,y,(uint8_t)*s);
+  return x-start;
+}
+
+u8g2_uint_t U8G2::drawUTF8(u8g2_uint_t x,u8g2_uint_t y,const char *s) {
+  u8g2_uint_t start=x;
+  while (*s) {
+    uint8_t length=utf8Length(*s);
+    uint16_t encoding=(length==1?(uint8_t)*s:((uint8_t)s[0]&(0x7f>>length))<<6|((uint8_t)s[1]&0x3f));
+    x+=drawGlyph(x,y,encoding);
+    for (uint8_t i=0;i<length && *s;i++)
+      s++;
+  }
+  return x-start;
+}
+
+// end of file
@@ -0,0 +1,207 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// (C) 2023 Dirk Hillbrecht
+
+// Minimal U8g2 for building UiUiUi, its benchmark and the widget checks on a Linux host
+//
+// This is not U8g2, only the part of its interface which UiUiUi uses, with the same names and
+// the same frame buffer layout (vertical bytes, least significant bit on top, as with the SSD1306).
+// Pixels, lines, boxes and bitmaps are drawn exactly. Fonts only have fixed metrics and draw
+// a pattern which depends on the character, so text changes lead to realistic display updates,
+// but the pixels do not show readable letters.
+//
+// Sending tiles goes through u8x8_DrawTile() and the display callback as in U8g2, so sketches
+// which count bytes and tiles in their callbacks work unchanged. Additionally, every call of
+// U8G2::updateDisplayArea() is recorded in u8g2HostUpdates. The log marks calls which send tiles
+// from another buffer than U8g2's own, e.g. from the back buffer of UIDisplay::setBackBuffer().
+// It also contains the u8x8_DrawTile() calls made directly, e.g. by UIDisplay with a page buffer.
+// What the display would show is kept in u8g2HostScreen.
+
+#pragma once
+
+#include "Arduino.h"
+
+typedef uint16_t u8g2_uint_t;
+
+struct u8x8_struct;
+typedef struct u8x8_struct u8x8_t;
+struct u8g2_struct;
+typedef struct u8g2_struct u8g2_t;
+
+typedef uint8_t (*u8x8_msg_cb)(u8x8_t *u8x8,uint8_t msg,uint8_t arg_int,void *arg_ptr);
+typedef void (*u8g2_draw_ll_hvline_cb)(u8g2_t *u8g2,u8g2_uint_t x,u8g2_uint_t y,u8g2_uint_t len,uint8_t dir);
+
+/** Display rotation, U8G2_R0 to U8G2_R3 */
+struct u8g2_cb_t {
+  uint8_t quarterTurns;
+};
+
+extern const u8g2_cb_t u8g2_cb_r0,u8g2_cb_r1,u8g2_cb_r2,u8g2_cb_r3;
+
+#define U8G2_R0 (&u8g2_cb_r0)
+#define U8G2_R1 (&u8g2_cb_r1)
+#define U8G2_R2 (&u8g2_cb_r2)
+#define U8G2_R3 (&u8g2_cb_r3)
+
+#define U8X8_PIN_NONE 255
+
+#define U8X8_MSG_DISPLAY_DRAW_TILE 15
+#define U8X8_MSG_BYTE_SEND 23
+
+struct u8x8_display_info_t {
+  uint8_t tile_width;
+  uint8_t tile_height;
+  u8g2_uint_t pixel_width;
+  u8g2_uint_t pixel_height;
+};
+
+struct u8x8_tile_t {
+  uint8_t *tile_ptr;
+  uint8_t cnt;
+  uint8_t x_pos;
+  uint8_t y_pos;
+};
+
+struct u8x8_struct {
+  const u8x8_display_info_t *display_info;
+  u8x8_msg_cb display_cb;
+  u8x8_msg_cb byte_cb;
+  u8x8_msg_cb gpio_and_delay_cb;
+};
+
+struct u8g2_struct {
+  u8x8_t u8x8;
+  const u8g2_cb_t *cb;
+  u8g2_draw_ll_hvline_cb ll_hvline;
+  uint8_t *tile_buf_ptr;
+  uint8_t tile_buf_height;
+  uint8_t tile_curr_row;
+  u8g2_uint_t width,height;
+  u8g2_uint_t user_x0,user_x1,user_y0,user_y1;
+  u8g2_uint_t clip_x0,clip_x1,clip_y0,clip_y1;
+  const uint8_t *font;
+  uint8_t draw_color;
+  uint8_t bitmap_transparency;
+};
+
+/** Fonts of the examples: advance width, height above the baseline and below it, pixels drawn beyond the advance width */
+extern const uint8_t u8g2_font_6x10_tf[];
+extern const uint8_t u8g2_font_crox3cb_tf[];
+extern const uint8_t u8g2_font_helvBO10_tf[];  // oblique, each glyph reaches into the next one
+extern const uint8_t u8g2_font_streamline_interface_essential_circle_triangle_t[];
+extern const uint8_t u8g2_font_streamline_interface_essential_wifi_t[];
+
+/** Marker functions for the frame buffer layout, only compared by address */
+void u8g2_ll_hvline_vertical_top_lsb(u8g2_t *u8g2,u8g2_uint_t x,u8g2_uint_t y,u8g2_uint_t len,uint8_t dir);
+void u8g2_ll_hvline_horizontal_right_lsb(u8g2_t *u8g2,u8g2_uint_t x,u8g2_uint_t y,u8g2_uint_t len,uint8_t dir);
+
+uint8_t u8x8_dummy_cb(u8x8_t *u8x8,uint8_t msg,uint8_t arg_int,void *arg_ptr);
+uint8_t u8x8_DrawTile(u8x8_t *u8x8,uint8_t x,uint8_t y,uint8_t cnt,uint8_t *tile_ptr);
+
+/** SSD1306 with 128x64 pixels and full frame buffer, the driver only sends address commands and tile data */
+void u8g2_Setup_ssd1306_128x64_noname_f(u8g2_t *u8g2,const u8g2_cb_t *rotation,u8x8_msg_cb byte_cb,u8x8_msg_cb gpio_and_delay_cb);
+
+/** The same display with a page buffer of one tile row */
+void u8g2_Setup_ssd1306_128x64_noname_1(u8g2_t *u8g2,const u8g2_cb_t *rotation,u8x8_msg_cb byte_cb,u8x8_msg_cb gpio_and_delay_cb);
+
+/** The same display with a page buffer of two tile rows */
+void u8g2_Setup_ssd1306_128x64_noname_2(u8g2_t *u8g2,const u8g2_cb_t *rotation,u8x8_msg_cb byte_cb,u8x8_msg_cb gpio_and_delay_cb);
+
+u8x8_t *u8g2_GetU8x8(u8g2_t *u8g2);
+uint8_t *u8g2_GetBufferPtr(u8g2_t *u8g2);
+void u8g2_SetBufferCurrTileRow(u8g2_t *u8g2,uint8_t row);
+int8_t u8g2_GetGlyphWidth(u8g2_t *u8g2,uint16_t requested_encoding);
+
+/** Record of all U8G2::updateDisplayArea() calls */
+struct U8g2HostUpdates {
+  unsigned long calls;  ///< Number of calls
+  unsigned long tiles;  ///< Number of tiles in all calls
+  bool log;             ///< Print every call on stdout
+};
+
+extern U8g2HostUpdates u8g2HostUpdates;
+
+/** Content of the display RAM as written by the tiles sent to the display */
+extern uint8_t u8g2HostScreen[1024];
+
+class U8G2 {
+
+  protected:
+
+    u8g2_t u8g2;
+
+  public:
+
+    U8G2();
+
+    u8g2_t *getU8g2() { return &u8g2; }
+    u8x8_t *getU8x8() { return &u8g2.u8x8; }
+
+    void begin() {}
+    void setPowerSave(uint8_t is_enable) {}
+
+    u8g2_uint_t getDisplayWidth() { return u8g2.width; }
+    u8g2_uint_t getDisplayHeight() { return u8g2.height; }
+
+    uint8_t *getBufferPtr() { return u8g2.tile_buf_ptr; }
+    uint8_t getBufferTileWidth() { return u8g2.u8x8.display_info->tile_width; }
+    uint8_t getBufferTileHeight() { return u8g2.tile_buf_height; }
+    uint8_t getBufferCurrTileRow() { return u8g2.tile_curr_row; }
+    void setBufferCurrTileRow(uint8_t row) { u8g2_SetBufferCurrTileRow(&u8g2,row); }
+
+    void clearBuffer();
+    void sendBuffer();
+    void firstPage();
+    uint8_t nextPage();
+    void updateDisplayArea(uint8_t tx,uint8_t ty,uint8_t tw,uint8_t th);
+
+    void setDrawColor(uint8_t color) { u8g2.draw_color=color; }
+    void setBitmapMode(uint8_t is_transparent) { u8g2.bitmap_transparency=is_transparent; }
+    void setClipWindow(u8g2_uint_t x0,u8g2_uint_t y0,u8g2_uint_t x1,u8g2_uint_t y1);
+    void setMaxClipWindow();
+
+    void drawPixel(u8g2_uint_t x,u8g2_uint_t y);
+    void drawHLine(u8g2_uint_t x,u8g2_uint_t y,u8g2_uint_t w);
+    void drawVLine(u8g2_uint_t x,u8g2_uint_t y,u8g2_uint_t h);
+    void drawLine(u8g2_uint_t x1,u8g2_uint_t y1,u8g2_uint_t x2,u8g2_uint_t y2);
+    void drawBox(u8g2_uint_t x,u8g2_uint_t y,u8g2_uint_t w,u8g2_uint_t h);
+    void drawFrame(u8g2_uint_t x,u8g2_uint_t y,u8g2_uint_t w,u8g2_uint_t h);
+    void drawXBM(u8g2_uint_t x,u8g2_uint_t y,u8g2_uint_t w,u8g2_uint_t h,const uint8_t *bitmap);
+    void drawXBMP(u8g2_uint_t x,u8g2_uint_t y,u8g2_uint_t w,u8g2_uint_t h,const uint8_t *bitmap) { drawXBM(x,y,w,h,bitmap); }
+
+    void setFont(const uint8_t *font) { u8g2.font=font; }
+    void setFontPosTop() {}
+    void setFontDirection(uint8_t dir) {}
+    void setFontRefHeightExtendedText() {}
+    int8_t getAscent() { return u8g2.font[1]; }
+    int8_t getDescent() { return -(int8_t)u8g2.font[2]; }
+    u8g2_uint_t getStrWidth(const char *s);
+    u8g2_uint_t getUTF8Width(const char *s);
+    u8g2_uint_t drawGlyph(u8g2_uint_t x,u8g2_uint_t y,uint16_t encoding);
+    u8g2_uint_t drawStr(u8g2_uint_t x,u8g2_uint_t y,const char *s);
+    u8g2_uint_t drawUTF8(u8g2_uint_t x,u8g2_uint_t y,const char *s);
+
+};
+
+/** SSD1306 with full frame buffer, nothing is sent anywhere, the page buffer variants follow */
+class U8G2_SSD1306_128X64_NONAME_F_HW_I2C: public U8G2 {
+  public:
+    U8G2_SSD1306_128X64_NONAME_F_HW_I2C(const u8g2_cb_t *rotation,uint8_t reset=U8X8_PIN_NONE,uint8_t clock=U8X8_PIN_NONE,uint8_t data=U8X8_PIN_NONE): U8G2() {
+      u8g2_Setup_ssd1306_128x64_noname_f(&u8g2,rotation,u8x8_dummy_cb,u8x8_dummy_cb);
+    }
+};
+
+class U8G2_SSD1306_128X64_NONAME_1_HW_I2C: public U8G2 {
+  public:
+    U8G2_SSD1306_128X64_NONAME_1_HW_I2C(const u8g2_cb_t *rotation,uint8_t reset=U8X8_PIN_NONE,uint8_t clock=U8X8_PIN_NONE,uint8_t data=U8X8_PIN_NONE): U8G2() {
+      u8g2_Setup_ssd1306_128x64_noname_1(&u8g2,rotation,u8x8_dummy_cb,u8x8_dummy_cb);
+    }
+};
+
+class U8G2_SSD1306_128X64_NONAME_2_HW_I2C: public U8G2 {
+  public:
+    U8G2_SSD1306_128X64_NONAME_2_HW_I2C(const u8g2_cb_t *rotation,uint8_t reset=U8X8_PIN_NONE,uint8_t clock=U8X8_PIN_NONE,uint8_t data=U8X8_PIN_NONE): U8G2() {
+      u8g2_Setup_ssd1306_128x64_noname_2(&u8g2,rotation,u8x8_dummy_cb,u8x8_dummy_cb);
+    }
+};
+
+// end of file
@@ -0,0 +1,247 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// (C) 2023 Dirk Hillbrecht
+
+// Checks of single widgets on the host
+//
+// Each check sets up a small interface, changes it and prints what has been rendered.
+// "make check" compares the output with WidgetChecks.expected. Where a widget renders only
+// a part of itself, the check also compares the frame buffer with a forced rendering
+// of the same state, which must look exactly the same.
+
+#include "Arduino.h"
+#include <U8g2lib.h>
+
+#include <UiUiUi.h>
+
+// The image of the bitmap checks and its conversions by extras/xbm2uiuiui.py, generated by the Makefile
+#include "uiuiui.xbm"
+#include "uiuiui_tiles.h"
+#include "uiuiui_rle.h"
+
+U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2(U8G2_R0);
+
+// Frame buffer content before a forced rendering
+static uint8_t partialBuffer[1024];
+
+/* Print the area in the same form as UIArea::debugPrint(), but on one line with the label. */
+void printArea(const char* label,UIArea* area) {
+  printf("%s: (%d,%d)-(%d,%d)\n",label,area->left,area->top,area->right,area->bottom);
+}
+
+/* Render the display forced and return whether the frame buffer has not changed by this. */
+bool looksLikeForced(UIDisplay* display) {
+  memcpy(partialBuffer,u8g2.getBufferPtr(),sizeof(partialBuffer));
+  display->render(&u8g2,true);
+  return memcmp(partialBuffer,u8g2.getBufferPtr(),sizeof(partialBuffer))==0;
+}
+
+
+// *** UISprite ***
+
+// Three 16x8 frames in XBMP format: empty, a 3x3 block at (3,2), the block and a pixel at (12,7)
+const uint8_t spriteXBMP[] PROGMEM = {
+  0x00,0x00, 0x00,0x00, 0x00,0x00, 0x00,0x00, 0x00,0x00, 0x00,0x00, 0x00,0x00, 0x00,0x00,
+  0x00,0x00, 0x00,0x00, 0x38,0x00, 0x38,0x00, 0x38,0x00, 0x00,0x00, 0x00,0x00, 0x00,0x00,
+  0x00,0x00, 0x00,0x00, 0x38,0x00, 0x38,0x00, 0x38,0x00, 0x00,0x00, 0x00,0x00, 0x00,0x10,
+};
+
+// Two 8x16 frames in Tiles format: empty, pixels at (2,8) and (2,15)
+const uint8_t spriteTiles[] PROGMEM = {
+  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00, 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00, 0x00,0x00,0x81,0x00,0x00,0x00,0x00,0x00,
+};
+
+UISprite xbmpSprite=UISprite(16,8,spriteXBMP,3);
+UISprite tilesSprite=UISprite(8,16,spriteTiles,2,UIBitmapFormat::Tiles,UIAlignment::TopLeft,&xbmpSprite);
+UIRows spriteRows=UIRows(&tilesSprite);
+UIDisplay spriteDisplay=UIDisplay(&spriteRows);
+
+// Sprites in RLETiles format cannot switch frames
+UISprite rleSprite=UISprite(8,8,spriteTiles,2,UIBitmapFormat::RLETiles,UIAlignment::Center);
+
+/* Switch the frame of the sprite and print the box which is rendered anew. */
+void switchFrame(const char* label,UISprite* sprite,uint8_t frame) {
+  sprite->setFrame(frame);
+  printArea(label,sprite->render(&u8g2,false));
+  printf("  same as forced: %s\n",(looksLikeForced(&spriteDisplay)?"yes":"NO"));
+}
+
+void checkSprite() {
+  spriteDisplay.init(&u8g2);
+  switchFrame("XBMP sprite frame 0 to 1",&xbmpSprite,1);
+  switchFrame("XBMP sprite frame 1 to 2",&xbmpSprite,2);
+  switchFrame("XBMP sprite frame 2 to 0",&xbmpSprite,0);
+  switchFrame("XBMP sprite frame 0 to 0",&xbmpSprite,0);
+  switchFrame("Tiles sprite frame 0 to 1",&tilesSprite,1);
+  switchFrame("Tiles sprite frame 1 to 0",&tilesSprite,0);
+  rleSprite.setFrame(1);
+  printf("RLETiles sprite frame after setFrame(1): %d\n",rleSprite.getFrame());
+}
+
+
+// *** UITextLine with glyph offsets ***
+
+// Room for one offset more than the longest text, the long text is too wide for 8 bit offsets
+uint8_t clockOffsets[9],obliqueOffsets[6],longOffsets[51];
+
+UITextLine longLine=UITextLine(u8g2_font_6x10_tf,UIAlignment::CenterLeft);
+UITextLine obliqueLine=UITextLine(u8g2_font_helvBO10_tf,UIAlignment::Center,&longLine);
+UITextLine clockLine=UITextLine(u8g2_font_6x10_tf,UIAlignment::Center,&obliqueLine);
+UIRows textRows=UIRows(&clockLine);
+UIDisplay textDisplay=UIDisplay(&textRows);
+
+/* Change the text and print the area which is rendered anew. */
+void changeText(const char* label,UITextLine* line,const char* text) {
+  line->setText(text);
+  printArea(label,line->render(&u8g2,false));
+  printf("  same as forced: %s\n",(looksLikeForced(&textDisplay)?"yes":"NO"));
+}
+
+void checkTextLine() {
+  clockLine.setGlyphOffsets(clockOffsets,sizeof(clockOffsets));
+  obliqueLine.setGlyphOffsets(obliqueOffsets,sizeof(obliqueOffsets));
+  longLine.setGlyphOffsets(longOffsets,sizeof(longOffsets));
+  clockLine.setText("12:34:56");
+  obliqueLine.setText("12:34");
+  longLine.setText("0123456789012345678901234567890123456789012345678");
+  textDisplay.init(&u8g2);
+  printArea("Text line",clockLine.render(&u8g2,true));
+  changeText("Text line middle character",&clockLine,"12:35:56");
+  changeText("Text line last character",&clockLine,"12:35:57");
+  changeText("Text line first character",&clockLine,"22:35:57");
+  printArea("Oblique text line",obliqueLine.render(&u8g2,true));
+  changeText("Oblique text line middle character",&obliqueLine,"12:44");
+  changeText("Oblique text line last character",&obliqueLine,"12:45");
+  changeText("Oblique text line first character",&obliqueLine,"32:45");
+  changeText("Text line wider than 255 pixels",&longLine,"0123456789012345678901234567890123456789012345679");
+}
+
+
+// *** Bitmaps converted by xbm2uiuiui.py ***
+
+// Frame buffer content after drawing the original XBM image
+static uint8_t xbmpBuffer[1024];
+
+/* Draw the original image and the converted one with the top left corner at (x,y), return whether both look the same. */
+bool drawsLikeXBMP(U8G2* display,UICoordinate x,UICoordinate y,const uint8_t* bitmap,UIBitmapFormat format) {
+  UIArea area=UIArea(x,y,x+uiuiui_width,y+uiuiui_height);
+  UISize size=UISize(uiuiui_width,uiuiui_height);
+  display->setMaxClipWindow();
+  display->clearBuffer();
+  UIBitmap::drawBitmap(display,&area,&size,uiuiui_bits,UIAlignment::TopLeft);
+  memcpy(xbmpBuffer,display->getBufferPtr(),sizeof(xbmpBuffer));
+  display->clearBuffer();
+  UIBitmap::drawBitmap(display,&area,&size,bitmap,UIAlignment::TopLeft,format);
+  return memcmp(xbmpBuffer,display->getBufferPtr(),sizeof(xbmpBuffer))==0;
+}
+
+/* Compare both formats with the XBM image in each rotation, at a y coordinate which is a multiple of 8 and at one which is not. */
+void checkConvertedBitmaps() {
+  const u8g2_cb_t* rotations[]={U8G2_R0,U8G2_R1,U8G2_R2,U8G2_R3};
+  for (uint8_t r=0;r<4;r++) {
+    U8G2_SSD1306_128X64_NONAME_F_HW_I2C rotated(rotations[r]);
+    printf("R%u converted bitmaps same as XBMP: Tiles %s/%s, RLETiles %s/%s\n",r,
+      (drawsLikeXBMP(&rotated,8,16,uiuiui_tiles,UIBitmapFormat::Tiles)?"yes":"NO"),
+      (drawsLikeXBMP(&rotated,5,11,uiuiui_tiles,UIBitmapFormat::Tiles)?"yes":"NO"),
+      (drawsLikeXBMP(&rotated,8,16,uiuiui_rle,UIBitmapFormat::RLETiles)?"yes":"NO"),
+      (drawsLikeXBMP(&rotated,5,11,uiuiui_rle,UIBitmapFormat::RLETiles)?"yes":"NO"));
+  }
+}
+
+
+// *** Page buffer ***
+
+// Each page is one tile row high, so the three lines of 10 pixels share pages
+U8G2_SSD1306_128X64_NONAME_1_HW_I2C u8g2Page(U8G2_R0);
+
+UITextLine pageLine3=UITextLine(u8g2_font_6x10_tf,UIAlignment::CenterLeft);
+UITextLine pageLine2=UITextLine(u8g2_font_6x10_tf,UIAlignment::CenterLeft,&pageLine3);
+UITextLine pageLine1=UITextLine(u8g2_font_6x10_tf,UIAlignment::CenterLeft,&pageLine2);
+UIRows pageRows=UIRows(&pageLine1);
+UIDisplay pageDisplay=UIDisplay(&pageRows);
+
+/* Render page by page and compare what has been sent to the display with a forced rendering in a full buffer. */
+void renderPages(const char* label) {
+  pageDisplay.render(&u8g2Page);
+  memcpy(partialBuffer,u8g2HostScreen,sizeof(partialBuffer));
+  pageDisplay.init(&u8g2,true,false);
+  pageDisplay.render(&u8g2,true);
+  printf("%s\n  display same as forced: %s\n",label,(memcmp(partialBuffer,u8g2.getBufferPtr(),sizeof(partialBuffer))==0?"yes":"NO"));
+  pageDisplay.init(&u8g2Page,true,false);
+}
+
+void checkPages() {
+  pageLine1.setText("Line 1");
+  pageLine2.setText("Line 2");
+  pageLine3.setText("Line 3");
+  pageDisplay.init(&u8g2Page);
+  pageLine2.setText("Line two");
+  renderPages("Page buffer one line");
+  pageLine1.setText("First line");
+  pageLine3.setText("Third line");
+  renderPages("Page buffer two lines");
+  pageLine2.setMinUpdateInterval(60000);
+  pageLine2.setText("Line 2");
+  pageLine1.setText("Line 1");
+  renderPages("Page buffer deferred line on a rendered page");
+}
+
+
+// *** Deferred rendering ***
+
+// Envelope which leaves held back changes to the default of UIParent, as a parent written for an application may do
+class PlainEnvelope: public UIEnvelope {
+  public:
+    PlainEnvelope(UIWidget* content): UIEnvelope(UIExpansion::None,UIAlignment::Center,content) {}
+    void childDefersRendering(UIWidget *child,UIArea *area,uint16_t millis) { UIParent::childDefersRendering(child,area,millis); }
+};
+
+UITextLine deferringLine=UITextLine(u8g2_font_6x10_tf);
+UIRows deferringRows=UIRows(&deferringLine);
+UIDisplay deferringDisplay=UIDisplay(&deferringRows);
+
+UITextLine plainLine=UITextLine(u8g2_font_6x10_tf);
+PlainEnvelope plainEnvelope=PlainEnvelope(&plainLine);
+UIRows plainRows=UIRows(&plainEnvelope);
+UIDisplay plainDisplay=UIDisplay(&plainRows);
+
+/* Change the text twice within 100 ms, then render like a render worker: call render() after getRenderDelay() until nothing is left. */
+void changeTwice(const char* label,UIDisplay* display,UITextLine* line) {
+  setFakeMillis(10000);
+  line->setText("Value 1");
+  display->init(&u8g2);
+  line->setMinUpdateInterval(1000);
+  setFakeMillis(10100);
+  line->setText("Value 2");
+  display->render(&u8g2);
+  setFakeMillis(10200);
+  line->setText("Value 3");
+  unsigned long renderCalls=1,updates=u8g2HostUpdates.calls,updateMillis=0;
+  for (uint32_t delay=display->getRenderDelay();delay>0;delay=display->getRenderDelay()) {
+    setFakeMillis(millis()+delay);
+    display->render(&u8g2);
+    renderCalls++;
+    if (u8g2HostUpdates.calls>updates && !updateMillis)
+      updateMillis=millis();
+  }
+  printf("%s: %lu display update at %lu ms after %lu render calls\n",label,u8g2HostUpdates.calls-updates,updateMillis-10000,renderCalls);
+  printf("  same as forced: %s\n",(looksLikeForced(display)?"yes":"NO"));
+}
+
+/* Runs last, time does not pass anymore afterwards. */
+void checkDeferral() {
+  changeTwice("Text line in rows",&deferringDisplay,&deferringLine);
+  changeTwice("Text line in envelope with default deferral",&plainDisplay,&plainLine);
+}
+
+
+int main() {
+  checkSprite();
+  checkTextLine();
+  checkConvertedBitmaps();
+  checkPages();
+  checkDeferral();
+  return 0;
+}
+
+// end of file
@@ -0,0 +1,20 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// (C) 2023 Dirk Hillbrecht
+
+// Runs the RenderBenchmark sketch once on the host
+//
+// "-v" prints every U8G2::updateDisplayArea() call before the result line of its measurement.
+
+#include "Arduino.h"
+#include <U8g2lib.h>
+
+#include "../../examples/RenderBenchmark/RenderBenchmark.ino"
+
+int main(int argc,char **argv) {
+  u8g2HostUpdates.log=(argc>1 && strcmp(argv[1],"-v")==0);
+  setup();
+  printf("updateDisplayArea: %lu calls, %lu tiles\n",u8g2HostUpdates.calls,u8g2HostUpdates.tiles);
+  return 0;
+}
+
+// end of file
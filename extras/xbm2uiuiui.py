@@ -0,0 +1,108 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: BSD-2-Clause
+# (C) 2023 Dirk Hillbrecht
+
+"""Convert an XBM image into a bitmap format of UiUiUi's UIBitmap.
+
+Usage: xbm2uiuiui.py [--format rle] [--name NAME] image.xbm
+
+The XBM file may also be a C/C++ source snippet as produced by GIMP or
+as used in the UiUiUi examples: two "#define ..._width/_height" lines and
+one array of hex bytes. The result is printed as C++ source code on stdout.
+
+Formats:
+
+  rle    Run-length encoded tiles (UIBitmapFormat::RLETiles), see UIBitmap.h
+  tiles  Uncompressed tiles (UIBitmapFormat::Tiles), copied with memcpy_P()
+         if the bitmap starts at a y coordinate which is a multiple of 8
+"""
+
+import argparse
+import re
+import sys
+
+
+def read_xbm(text):
+    """Return width, height, name and data bytes of the XBM image in the text."""
+    width = re.search(r"#define\s+(\w*?)_?width\s+(\d+)", text)
+    height = re.search(r"#define\s+\w*?_?height\s+(\d+)", text)
+    if not width or not height:
+        sys.exit("No width or height definition found")
+    data = text[text.index("{") + 1:text.index("}")]
+    values = [int(v, 16) for v in re.findall(r"0x[0-9a-fA-F]+", data)]
+    return int(width.group(2)), int(height.group(1)), width.group(1) or "image", values
+
+
+def to_tiles(width, height, xbm):
+    """Convert the row-major XBM bytes into U8g2's tile layout."""
+    stride = (width + 7) // 8
+    tiles = []
+    for tile_row in range((height + 7) // 8):
+        for x in range(width):
+            bits = 0
+            for bit in range(8):
+                y = tile_row * 8 + bit
+                if y < height and xbm[y * stride + x // 8] & (1 << (x % 8)):
+                    bits |= 1 << bit
+            tiles.append(bits)
+    return tiles
+
+
+def encode_rle(tiles):
+    """Encode the tile bytes in the RLETiles format of UIBitmap."""
+    result = []
+    literal = []
+
+    def flush_literal():
+        while literal:
+            block = literal[:128]
+            del literal[:128]
+            result.append(len(block) - 1)
+            result.extend(block)
+
+    i = 0
+    while i < len(tiles):
+        run = 1
+        while i + run < len(tiles) and run < 64 and tiles[i + run] == tiles[i]:
+            run += 1
+        if tiles[i] == 0 and (run >= 2 or not literal):
+            flush_literal()
+            result.append(0x80 | (run - 1))
+        elif run >= 3:
+            flush_literal()
+            result.extend([0xc0 | (run - 1), tiles[i]])
+        else:
+            literal.extend(tiles[i:i + run])
+        i += run
+    flush_literal()
+    return result
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert an XBM image into a UiUiUi bitmap format.")
+    parser.add_argument("--format", choices=["rle", "tiles"], default="rle", help="target format (default: rle)")
+    parser.add_argument("--name", help="name of the generated array (default: name from the XBM file)")
+    parser.add_argument("xbm", help="XBM file to convert")
+    args = parser.parse_args()
+    with open(args.xbm) as f:
+        width, height, name, xbm = read_xbm(f.read())
+    if len(xbm) < ((width + 7) // 8) * height:
+        sys.exit("Not enough data for a %dx%d image" % (width, height))
+    name = args.name or name
+    tiles = to_tiles(width, height, xbm)
+    if args.format == "rle":
+        data, suffix, format_name = encode_rle(tiles), "rle", "RLETiles"
+    else:
+        data, suffix, format_name = tiles, "tiles", "Tiles"
+    print("// %s: %dx%d pixels, %d bytes as XBM, %d bytes as %s" % (name, width, height, len(xbm), len(data), format_name))
+    print("// UIBitmap %s=UIBitmap(%d,%d,%s_%s,UIBitmapFormat::%s,UIAlignment::Center);" % (name, width, height, name, suffix, format_name))
+    print("const uint8_t %s_%s[] PROGMEM = {" % (name, suffix))
+    for i in range(0, len(data), 12):
+        print("  " + ", ".join("0x%02x" % b for b in data[i:i + 12]) + ",")
+    print("};")
+
+
+if __name__ == "__main__":
+    main()
+
+# end of file
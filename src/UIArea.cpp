@@ -8,7 +8,7 @@
 #include "UIArea.h"
 
 /** Dimension consisting of left, top, right, and bottom value. */
-UIArea::UIArea(uint16_t left,uint16_t top,uint16_t right,uint16_t bottom):
+UIArea::UIArea(UICoordinate left,UICoordinate top,UICoordinate right,UICoordinate bottom):
   left(left),top(top),right(right),bottom(bottom) {}
 
 UIArea::UIArea(): UIArea(0,0,0,0) {}
@@ -17,12 +17,12 @@ UIArea::UIArea(UIArea* dim):
   left(dim->left),top(dim->top),right(dim->right),bottom(dim->bottom) {}
 
 UIArea::UIArea(UIPoint *topLeft,UISize *size):
-  left(topLeft->x),top(topLeft->y),right(topLeft->x+size->width),bottom(topLeft->y+size->height) {}
+  left(topLeft->x),top(topLeft->y),right(UISize::max_len_or(topLeft->x+size->width)),bottom(UISize::max_len_or(topLeft->y+size->height)) {}
 
-UIArea::UIArea(UIPoint *topLeft,uint16_t width,uint16_t height):
-  left(topLeft->x),top(topLeft->y),right(topLeft->x+width),bottom(topLeft->y+height) {}
+UIArea::UIArea(UIPoint *topLeft,UICoordinate width,UICoordinate height):
+  left(topLeft->x),top(topLeft->y),right(UISize::max_len_or(topLeft->x+width)),bottom(UISize::max_len_or(topLeft->y+height)) {}
 
-void UIArea::set(uint16_t left,uint16_t top,uint16_t right,uint16_t bottom) {
+void UIArea::set(UICoordinate left,UICoordinate top,UICoordinate right,UICoordinate bottom) {
   this->left=left;this->top=top;this->right=right;this->bottom=bottom;
 }
 
@@ -33,12 +33,12 @@ void UIArea::set(const UIArea *source) {
 
 void UIArea::set(UIPoint *topLeft,UISize *size) {
   left=topLeft->x;top=topLeft->y;
-  right=left+size->width; bottom=top+size->height;
+  right=UISize::max_len_or(left+size->width); bottom=UISize::max_len_or(top+size->height);
 }
 
-void UIArea::set(UIPoint *topLeft,uint16_t width,uint16_t height) {
+void UIArea::set(UIPoint *topLeft,UICoordinate width,UICoordinate height) {
   left=topLeft->x;top=topLeft->y;
-  right=left+width; bottom=top+height;
+  right=UISize::max_len_or(left+width); bottom=UISize::max_len_or(top+height);
 }
 
 void UIArea::clear() {
@@ -67,27 +67,42 @@ void UIArea::intersectWith(UIArea* area) {
     this->left=(this->left>this->right ? area->left : max(this->left,area->left));
     this->right=min(this->right,area->right);
     this->top=(this->top>this->bottom ? area->top : max(this->top,area->top));
-    this->bottom=max(this->bottom,area->bottom);
+    this->bottom=min(this->bottom,area->bottom);
   }
   else
     this->clear();
 }
 
+bool UIArea::overlaps(UIArea* area) {
+  return (hasArea() && area->hasArea() &&
+          left<area->right && area->left<right &&
+          top<area->bottom && area->top<bottom);
+}
+
+bool UIArea::equals(UIArea* area) {
+  return left==area->left && top==area->top && right==area->right && bottom==area->bottom;
+}
+
 void UIArea::shrink(UISize *diff) {
-  left+=diff->width;
-  right=max(left,right>diff->width?(uint16_t)(right-diff->width):(uint16_t)0);
-  top+=diff->height;
-  bottom=max(top,bottom>diff->height?(uint16_t)(bottom-diff->height):(uint16_t)0);
+  left=UISize::max_len_or(left+diff->width);
+  right=max(left,right>diff->width?(UICoordinate)(right-diff->width):(UICoordinate)0);
+  top=UISize::max_len_or(top+diff->height);
+  bottom=max(top,bottom>diff->height?(UICoordinate)(bottom-diff->height):(UICoordinate)0);
 }
 
 UIPoint UIArea::alignedTopLeft(UIAlignment alignment,UISize *element) {
-  uint16_t x=(alignment==UIAlignment::TopLeft || alignment==UIAlignment::CenterLeft || alignment==UIAlignment::BottomLeft)?left:
+  int x=(alignment==UIAlignment::TopLeft || alignment==UIAlignment::CenterLeft || alignment==UIAlignment::BottomLeft)?left:
   (alignment==UIAlignment::TopCenter || alignment==UIAlignment::Center || alignment==UIAlignment::BottomCenter)?((right+left)-element->width)/2:
   right-element->width;
-  uint16_t y=(alignment==UIAlignment::TopLeft || alignment==UIAlignment::TopCenter || alignment==UIAlignment::TopRight)?top:
+  int y=(alignment==UIAlignment::TopLeft || alignment==UIAlignment::TopCenter || alignment==UIAlignment::TopRight)?top:
   (alignment==UIAlignment::CenterLeft || alignment==UIAlignment::Center || alignment==UIAlignment::CenterRight)?((bottom+top)-element->height)/2:
   bottom-element->height;
-  return UIPoint(x,y);
+#if UIUIUI_COMPACT_COORDINATES
+  // 8-bit coordinates of an element sticking out left or above the display would wrap to its far end
+  return UIPoint(max(x,0),max(y,0));
+#else
+  return UIPoint(x,y);  // U8g2 clips 16-bit coordinates which have wrapped around below 0
+#endif
 }
 
 UISize UIArea::getSize() {
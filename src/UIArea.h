@@ -27,7 +27,7 @@ class UIArea final {
     static UIArea EMPTY;
 
     /** Initialize area from four explicit values. */
-    UIArea(uint16_t left,uint16_t top,uint16_t right,uint16_t bottom);
+    UIArea(UICoordinate left,UICoordinate top,UICoordinate right,UICoordinate bottom);
 
     /** Initialize empty area: All values 0. */
     UIArea();
@@ -39,10 +39,10 @@ class UIArea final {
     UIArea(UIPoint *topLeft,UISize *size);
 
     /** Initialize area with top left point and a size */
-    UIArea(UIPoint *topLeft,uint16_t width,uint16_t height);
+    UIArea(UIPoint *topLeft,UICoordinate width,UICoordinate height);
 
     /** Set values of this area from four distinct values. */
-    void set(uint16_t left,uint16_t top,uint16_t right,uint16_t bottom);
+    void set(UICoordinate left,UICoordinate top,UICoordinate right,UICoordinate bottom);
 
     /** Set values of this area from given other referenced area. */
     void set(const UIArea *source);
@@ -51,7 +51,7 @@ class UIArea final {
     void set(UIPoint *topLeft,UISize *size);
 
     /** Set this area from the top-left point and a width and a height given directly. */
-    void set(UIPoint *topLeft,uint16_t width,uint16_t height);
+    void set(UIPoint *topLeft,UICoordinate width,UICoordinate height);
 
     /** sets this area to (0,0,0,0) and make it "clear" this way. */
     void clear();
@@ -75,16 +75,25 @@ class UIArea final {
      * If left is larger than right, it is set to dim->left,
      * if top is larger than bottom it is set to dim->top.
      * This can happen if an underflow occurs
-     * and the value which would be smaller than 0 flips to some 65500 values.
+     * and the value which would be smaller than 0 flips to some large value.
      *
      * @param area Other area with which this area is intersected.
      */
     void intersectWith(UIArea* area);
 
+    /** Return whether this area and the referenced one have at least one point in common. */
+    bool overlaps(UIArea* area);
+
+    /** Return whether this area has exactly the same coordinates as the referenced one. */
+    bool equals(UIArea* area);
+
     /** Shrink this area by the given width and height on each side (so diff is applied twice in each direction). */
     void shrink(UISize *diff);
 
-    /** Return the top-left point of an area of the given element if that element is aligned as stated in the alignment. */
+    /** Return the top-left point of an area of the given element if that element is aligned as stated in the alignment.
+     *
+     * If the element is larger than this area, it is aligned at the left or top side.
+     */
     UIPoint alignedTopLeft(UIAlignment alignment,UISize *element);
 
     /** Return the size of this area. */
@@ -94,16 +103,16 @@ class UIArea final {
     void debugPrint(const char* label);
 
     /** Left coordinate of the area, 0 is leftmost, inclusive. */
-    uint16_t left;
+    UICoordinate left;
 
     /** Top coordinate of the area, 0 is topmost, inclusive. */
-    uint16_t top;
+    UICoordinate top;
 
     /** Right coordinate of the area, 0 is leftmost, exclusive. */
-    uint16_t right;
+    UICoordinate right;
 
     /** Bottom coordinate of the area, 0 is topmost, exclusive. */
-    uint16_t bottom;
+    UICoordinate bottom;
 
 };
 
@@ -0,0 +1,122 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// (C) 2023 Dirk Hillbrecht
+
+#include "Arduino.h"
+#include "UIArea.h"
+#include "UIAreaList.h"
+
+/* Initialize an empty area list. */
+UIAreaList::UIAreaList(): count(0) {}
+
+void UIAreaList::add(UIArea* area) {
+  if (!area->hasArea())
+    return;
+  UIArea candidate=UIArea(area);
+  while (true) {
+    // Unite the candidate with any area it overlaps or which it extends without waste.
+    // The united candidate might now overlap other areas, so start over afterwards.
+    uint8_t i=0;
+    while (i<count && !(candidate.overlaps(&areas[i]) || wasteOfUnion(&candidate,&areas[i])==0))
+      i++;
+    if (i<count) {
+      candidate.uniteWith(&areas[i]);
+      remove(i);
+      continue;
+    }
+    if (count<CAPACITY) {
+      areas[count++].set(&candidate);
+      return;
+    }
+    // List is full: Find the two areas - the candidate included - with the least wasteful union
+    uint8_t bestA=0,bestB=CAPACITY; // bestB==CAPACITY denotes the candidate
+    uint32_t bestWaste=wasteOfUnion(&areas[0],&candidate);
+    for (uint8_t a=0;a<CAPACITY;a++) {
+      uint32_t waste=wasteOfUnion(&areas[a],&candidate);
+      if (waste<bestWaste) {
+        bestWaste=waste;bestA=a;bestB=CAPACITY;
+      }
+      for (uint8_t b=a+1;b<CAPACITY;b++) {
+        waste=wasteOfUnion(&areas[a],&areas[b]);
+        if (waste<bestWaste) {
+          bestWaste=waste;bestA=a;bestB=b;
+        }
+      }
+    }
+    if (bestB==CAPACITY) {
+      candidate.uniteWith(&areas[bestA]);
+      remove(bestA);
+    }
+    else {
+      // Unite two areas of the list, the candidate takes the freed place.
+      // As the united area may now overlap others, it is the next candidate.
+      UIArea united=UIArea(&areas[bestA]);
+      united.uniteWith(&areas[bestB]);
+      remove(bestB);  // bestB>bestA, so removing it first keeps bestA valid
+      remove(bestA);
+      areas[count++].set(&candidate);
+      candidate.set(&united);
+    }
+  }
+}
+
+void UIAreaList::addAll(UIAreaList* other) {
+  for (uint8_t i=0;i<other->count;i++)
+    add(&other->areas[i]);
+}
+
+void UIAreaList::clear() {
+  count=0;
+}
+
+bool UIAreaList::isEmpty() {
+  return count==0;
+}
+
+uint8_t UIAreaList::getCount() {
+  return count;
+}
+
+UIArea* UIAreaList::get(uint8_t index) {
+  return &areas[index];
+}
+
+bool UIAreaList::take(UIArea* target) {
+  if (count==0) {
+    target->clear();
+    return false;
+  }
+  target->set(&areas[--count]);
+  return true;
+}
+
+UIArea UIAreaList::getEnclosure() {
+  UIArea enclosure=UIArea();
+  for (uint8_t i=0;i<count;i++)
+    enclosure.uniteWith(&areas[i]);
+  return enclosure;
+}
+
+void UIAreaList::debugPrint(const char* label) {
+  Serial.print(label);Serial.print("[");
+  Serial.print(count);Serial.println("]");
+  for (uint8_t i=0;i<count;i++)
+    areas[i].debugPrint("  ");
+}
+
+void UIAreaList::remove(uint8_t index) {
+  areas[index].set(&areas[--count]);
+}
+
+uint32_t UIAreaList::wasteOfUnion(UIArea* a,UIArea* b) {
+  UIArea united=UIArea(a);
+  united.uniteWith(b);
+  uint32_t unitedSize=sizeOf(&united);
+  uint32_t separateSize=sizeOf(a)+sizeOf(b);
+  return (unitedSize>separateSize?unitedSize-separateSize:0);
+}
+
+uint32_t UIAreaList::sizeOf(UIArea* area) {
+  return (area->hasArea()?(uint32_t)(area->right-area->left)*(uint32_t)(area->bottom-area->top):0);
+}
+
+// end of file
@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// (C) 2023 Dirk Hillbrecht
+
+#pragma once
+
+#include "Arduino.h"
+
+#include "UIConfig.h"
+#include "UIArea.h"
+
+/** Bounded list of disjoint areas.
+ *
+ * An area list collects a number of areas, e.g. the parts of the display which have changed
+ * during one rendering cycle. In contrast to UIArea::uniteWith(), adding an area to the list
+ * does not necessarily enlarge one rectangle up to the enclosure of all added areas.
+ * Two small changes in opposite corners of the display stay two small areas.
+ *
+ * The list is statically sized, it has room for CAPACITY areas, set by UIUIUI_AREA_LIST_SIZE in UIConfig.h.
+ * The areas in the list never overlap:
+ *
+ * * An added area which overlaps an area in the list is united with it.
+ * * An added area which can be united with an area in the list without enclosing
+ *   any additional points (e.g. two adjacent tiles in one row) is united with it.
+ * * If the list is full, the two areas whose union encloses the smallest number
+ *   of additional points are united.
+ *
+ * So, the list always describes _at least_ all the added areas, but it can also contain some more.
+ */
+class UIAreaList final {
+  public:
+
+    /** Maximum number of areas in the list. */
+    static const uint8_t CAPACITY=UIUIUI_AREA_LIST_SIZE;
+
+    static_assert(UIUIUI_AREA_LIST_SIZE>0 && UIUIUI_AREA_LIST_SIZE<=255,"UIUIUI_AREA_LIST_SIZE must be between 1 and 255");
+
+    /** Initialize an empty area list. */
+    UIAreaList();
+
+    /** Add the referenced area to the list, merge it with existing areas as needed.
+     *
+     * Empty areas are ignored.
+     */
+    void add(UIArea* area);
+
+    /** Add all areas of the referenced list to this list. */
+    void addAll(UIAreaList* other);
+
+    /** Remove all areas from the list. */
+    void clear();
+
+    /** Return whether the list contains no area at all. */
+    bool isEmpty();
+
+    /** Return the number of areas in the list. */
+    uint8_t getCount();
+
+    /** Return the area with the given index, index must be smaller than getCount(). */
+    UIArea* get(uint8_t index);
+
+    /** Remove the last area of the list and store it in the target area.
+     *
+     * If the list is empty, target is cleared.
+     *
+     * @return true if an area has been taken from the list, false if the list was empty.
+     */
+    bool take(UIArea* target);
+
+    /** Return the smallest area enclosing all areas of this list. */
+    UIArea getEnclosure();
+
+    /** Debug output of this area list with some prepended label. */
+    void debugPrint(const char* label);
+
+  private:
+
+    /** The areas of this list, only the first "count" of them are valid. */
+    UIArea areas[CAPACITY];
+
+    /** Number of valid areas in the list. */
+    uint8_t count;
+
+    /** Remove the area with the given index from the list, the last area takes its place. */
+    void remove(uint8_t index);
+
+    /** Return the number of points the union of a and b encloses additionally to the points of a and b. */
+    static uint32_t wasteOfUnion(UIArea* a,UIArea* b);
+
+    /** Return the number of points in the area. */
+    static uint32_t sizeOf(UIArea* area);
+
+};
+
+// end of file
@@ -8,39 +8,80 @@
 #include "UIPoint.h"
 #include "UISize.h"
 #include "UIArea.h"
+#include "UIFrameBuffer.h"
 #include "UIWidget.h"
 #include "UIBitmap.h"
   
 /* Create a bitmap with the given width, height, XBMP, alignment, and potential successor*/
-UIBitmap::UIBitmap(uint16_t width, uint16_t height, const uint8_t *bitmap, UIAlignment alignment, UIWidget* next):
-  UIWidget(next),imageSize(width,height),bitmap(bitmap),alignment(alignment) {}
+UIBitmap::UIBitmap(UICoordinate width, UICoordinate height, const uint8_t *bitmap, UIAlignment alignment, UIWidget* next):
+  UIBitmap(width,height,bitmap,UIBitmapFormat::XBMP,alignment,next) {}
 
 /* Create a bitmap with the given width, height, XBMP, and potential successor*/
-UIBitmap::UIBitmap(uint16_t width, uint16_t height, const uint8_t *bitmap, UIWidget* next):
+UIBitmap::UIBitmap(UICoordinate width, UICoordinate height, const uint8_t *bitmap, UIWidget* next):
   UIBitmap(width,height,bitmap,UIAlignment::Center,next) {}
+
+/* Create a bitmap with the given width, height, bitmap data in the given format, alignment, and potential successor*/
+UIBitmap::UIBitmap(UICoordinate width, UICoordinate height, const uint8_t *bitmap, UIBitmapFormat format, UIAlignment alignment, UIWidget* next):
+  UIWidget(next),bitmap(bitmap),imageSize(width,height),alignment(alignment),format(format) {}
   
 UIArea* UIBitmap::render(U8G2* display,bool force) {
   // Only render image if forced
   if (force && dim.hasArea()) {
     clip(display);  // Clip every drawing to the frame buffer to this component's area.
-    clearBox(display,&dim); // Clear the entire widget area, even unused buffer/border
-	display->setDrawColor(1); // Setup painting
-    display->setBitmapMode(1);
-	UISize actualSize = dim.getSize();//get the available screen size and check if it is big enough for the bitmap
-	if(actualSize.width >= imageSize.width && actualSize.height >= imageSize.height){
-	  topLeft.setFrom(dim.alignedTopLeft(alignment,&imageSize));
-      display->drawXBMP(topLeft.x, topLeft.y, imageSize.width, imageSize.height, bitmap);//draw the bitmap
-	} else { //just draw a box with an X through it if the supplied area is not big enough
-	  display->drawFrame(dim.left, dim.top, actualSize.width, actualSize.height);
-	  display->drawLine(dim.left, dim.top, dim.right-1, dim.bottom-1);
-	  display->drawLine(dim.left, dim.bottom-1, dim.right-1, dim.top);
-	}
+    drawBitmap(display,&dim,&imageSize,bitmap,alignment,format);
     return &dim;//return the entire widget area because the background was cleared
   }
   else // No need to render: Return empty area
     return &UIArea::EMPTY;
 } // render()
 
+void UIBitmap::drawBitmap(U8G2* display,UIArea* dim,UISize* imageSize,const uint8_t* bitmap,UIAlignment alignment,UIBitmapFormat format) {
+  UIFrameBuffer::clear(display,dim); // Clear the entire widget area, even unused buffer/border
+  display->setDrawColor(1); // Setup painting
+  display->setBitmapMode(1);
+  UISize actualSize = dim->getSize();//get the available screen size and check if it is big enough for the bitmap
+  if(actualSize.width >= imageSize->width && actualSize.height >= imageSize->height){
+    UIPoint topLeft = dim->alignedTopLeft(alignment,imageSize);
+    if (format==UIBitmapFormat::RLETiles)
+      drawRLETiles(display,&topLeft,imageSize,bitmap);
+    else if (format==UIBitmapFormat::Tiles)
+      drawTiles(display,&topLeft,imageSize,bitmap);
+    else
+      display->drawXBMP(topLeft.x, topLeft.y, imageSize->width, imageSize->height, bitmap);//draw the bitmap
+  } else { //just draw a box with an X through it if the supplied area is not big enough
+    display->drawFrame(dim->left, dim->top, actualSize.width, actualSize.height);
+    display->drawLine(dim->left, dim->top, dim->right-1, dim->bottom-1);
+    display->drawLine(dim->left, dim->bottom-1, dim->right-1, dim->top);
+  }
+}
+
+/* Decode the control and data bytes and pass them to a tile writer, empty runs are only skipped */
+void UIBitmap::drawRLETiles(U8G2* display,UIPoint* topLeft,UISize* imageSize,const uint8_t* bitmap) {
+  UIFrameBuffer::TileWriter writer=UIFrameBuffer::TileWriter(display,topLeft,imageSize);
+  while (!writer.isFinished()) {
+    uint8_t control=pgm_read_byte(bitmap++);
+    uint8_t count=(control&0x3f)+1;
+    if (control<0x80) {
+      for (count=control+1;count>0;count--)
+        writer.put(pgm_read_byte(bitmap++));
+    }
+    else if (control<0xc0)
+      writer.skip(count);
+    else {
+      uint8_t bits=pgm_read_byte(bitmap++);
+      for (;count>0;count--)
+        writer.put(bits);
+    }
+  }
+}
+
+/* Pass the bitmap tile row by tile row to a tile writer */
+void UIBitmap::drawTiles(U8G2* display,UIPoint* topLeft,UISize* imageSize,const uint8_t* bitmap) {
+  UIFrameBuffer::TileWriter writer=UIFrameBuffer::TileWriter(display,topLeft,imageSize);
+  for (;!writer.isFinished();bitmap+=imageSize->width)
+    writer.putRow(bitmap);
+}
+
 void UIBitmap::computePreferredSize(U8G2 *display,UISize *preferredSize) {
   preferredSize->set(&imageSize);
 }
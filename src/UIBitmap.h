@@ -17,6 +17,23 @@
  *
  * Height and width must be supplied to match the XBMP data.
  * Alignment can be specified for cases where the bitmap is rendered in a larger area.
+ *
+ * Alternatively, the bitmap can be given in UiUiUi's run-length encoded tile format (RLETiles).
+ * It needs considerably less flash memory for images with large empty or filled parts,
+ * and it is decoded directly into the frame buffer. extras/xbm2uiuiui.py converts XBM files into this format.
+ *
+ * The format consists of U8g2's tile layout: The bitmap is stored tile row by tile row,
+ * each tile row column by column, each byte holds 8 pixels on top of each other, the least
+ * significant bit on top. These bytes are encoded in blocks, each starting with a control byte c:
+ *
+ * * c<0x80: c+1 literal bytes follow.
+ * * 0x80<=c<0xc0: (c&0x3f)+1 empty bytes, nothing follows. They are skipped while drawing.
+ * * c>=0xc0: (c&0x3f)+1 times the byte following.
+ *
+ * Bitmaps in the uncompressed tile layout (Tiles) need as much flash memory as XBMP,
+ * but if they start at the top of a tile row, i.e. at a y coordinate which is a multiple of 8,
+ * each tile row is copied into the frame buffer with one memcpy_P(). This is the fastest format
+ * for splash screens and large icons. extras/xbm2uiuiui.py also converts XBM files into this format.
  */
 class UIBitmap : public UIWidget {
 
@@ -26,36 +43,51 @@ class UIBitmap : public UIWidget {
 	 * 
 	 * The supplied width and height must match the bitmap data.
 	 * The bitmap data must be XBMP formated, and compiled into PROGMEM.  */
-    UIBitmap(uint16_t width, uint16_t height, const uint8_t *bitmap, UIAlignment alignment, UIWidget* next = nullptr);
+    UIBitmap(UICoordinate width, UICoordinate height, const uint8_t *bitmap, UIAlignment alignment, UIWidget* next = nullptr);
 
     /** Create a bitmap with default centered alignment and potential successor.
 	 * 
 	 * The supplied width and height must match the bitmap data.
 	 * The bitmap data must be XBMP formated, and compiled into PROGMEM.  */
-    UIBitmap(uint16_t width, uint16_t height, const uint8_t *bitmap, UIWidget* next = nullptr);
+    UIBitmap(UICoordinate width, UICoordinate height, const uint8_t *bitmap, UIWidget* next = nullptr);
+
+    /** Create a bitmap in the given format with supplied alignment and potential successor.
+     *
+     * The supplied width and height must match the bitmap data, which must be compiled into PROGMEM. */
+    UIBitmap(UICoordinate width, UICoordinate height, const uint8_t *bitmap, UIBitmapFormat format, UIAlignment alignment, UIWidget* next = nullptr);
 
     /** A bitmap is only rendered if the rendering is forced, otherwise it never changes. */
     UIArea* render(U8G2* display,bool force);
 
+    /** Draw a bitmap aligned into the given area, or a crossed box if it does not fit.
+     *
+     * This is the actual drawing operation of UIBitmap, also used by UIFlashBitmap.
+     * The area is cleared before, clipping must have been set by the caller.
+     */
+    static void drawBitmap(U8G2* display,UIArea* dim,UISize* imageSize,const uint8_t* bitmap,UIAlignment alignment,UIBitmapFormat format=UIBitmapFormat::XBMP);
+
   protected:
 
     /** Generate the preferred size from the bitmap size. */
     void computePreferredSize(U8G2 *display,UISize *preferredSize);
 
-  private:
-
-    /** The image to render, as a pointer to XBMP data in PROGMEM. */
+    /** The image to render, as a pointer to the bitmap data in PROGMEM. */
     const uint8_t* bitmap;
 
-    /** Size of the currently rendered text. */
+    /** Size of the image. */
     UISize imageSize;
 
     /** Alignment of the image in the widget's area */
     UIAlignment alignment;
 
-    /** Top left point of where the text to render. */
-    UIPoint topLeft;
+    /** Format of the bitmap data */
+    UIBitmapFormat format;
+
+    /** Decode a bitmap in RLETiles format into the display. */
+    static void drawRLETiles(U8G2* display,UIPoint* topLeft,UISize* imageSize,const uint8_t* bitmap);
 
+    /** Copy a bitmap in Tiles format into the display. */
+    static void drawTiles(U8G2* display,UIPoint* topLeft,UISize* imageSize,const uint8_t* bitmap);
 
 };
 
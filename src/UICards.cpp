@@ -11,6 +11,7 @@
 #include "UIPoint.h"
 #include "UISize.h"
 #include "UIArea.h"
+#include "UIAreaList.h"
 
 // Simple widgets
 #include "UIWidget.h"
@@ -25,7 +26,7 @@ void UICards::layout(U8G2* display,UIArea* dim) {
   UIWidgetGroup::layout(display,dim);
   UIWidget* widget=firstChild;
   while (widget) {
-    widget->layout(display,dim);
+    layoutChild(display,widget,dim);
     widget=widget->next;
   }
 }
@@ -53,18 +54,35 @@ UIArea* UICards::render(U8G2 *display,bool force) {
     if (visible)
       visible->render(display,true);
     this->forceInternally=false;
-    this->renderChildren=false;
+    this->dirtyChildren=0;
     return &dim;
   }
-  else if (force || this->renderChildren) {
-    UIArea *retval=(visible?visible->render(display,force):&UIArea::EMPTY);
-    this->renderChildren=false;
-    return retval;
+  else if (force || this->dirtyChildren) {
+    this->dirtyChildren=0;  // cleared before, so that a deferring child stays dirty
+    return (visible?visible->render(display,force):&UIArea::EMPTY);
   }
   else
     return &UIArea::EMPTY;
 }
 
+void UICards::doRenderAreas(U8G2 *display,bool force,UIAreaList* rendered) {
+  if (this->forceInternally) {  // complete area is re-rendered, the visible widget as in forced rendering
+    clip(display);
+    clearFull(display);
+    addRendered(rendered,&dim);
+    this->forceInternally=false;
+    this->dirtyChildren=0;
+    if (visible)
+      visible->renderAreas(display,true,rendered);
+  }
+  else if (force || this->dirtyChildren) {
+    if (!force || isWithinPage(display))  // forced page rendering may skip the visible widget, it keeps its changes
+      this->dirtyChildren=0;
+    if (visible)
+      visible->renderAreas(display,force,rendered);
+  }
+}
+
 void UICards::computePreferredSize(U8G2 *display,UISize *preferredSize) {
   UIWidget* elem=firstChild;
   while (elem) {
@@ -11,6 +11,7 @@
 #include "UIPoint.h"
 #include "UISize.h"
 #include "UIArea.h"
+#include "UIAreaList.h"
 
 // Simple widgets
 #include "UIWidget.h"
@@ -66,6 +67,9 @@ class UICards: public UIWidgetGroup {
 
   protected:
 
+    /** Render the cards widget group onto the display, collecting the changed areas of the visible widget separately. */
+    void doRenderAreas(U8G2 *display,bool force,UIAreaList* rendered);
+
     /** Compute the preferred size as the maximum envelope of the preferred sizes of all subwidgets. */
     void computePreferredSize(U8G2 *display,UISize *preferredSize);
 
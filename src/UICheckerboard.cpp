@@ -8,6 +8,7 @@
 
 #include "UISize.h"
 #include "UIWidget.h"
+#include "UIFrameBuffer.h"
 #include "UICheckerboard.h"
 
 
@@ -22,10 +23,12 @@ UICheckerboard::UICheckerboard(UIWidget* next): UICheckerboard(UISize(),next) {}
 UIArea* UICheckerboard::render(U8G2* display,bool force) {
   if (force) {
     clip(display);
-    display->setDrawColor(1);
-    for (uint16_t y=dim.top;y<dim.bottom;y+=16)
-      for (uint16_t x=dim.left;x<dim.right;x+=16)
-        display->drawXBM(x,y,16,16,checkerboard_bits);
+    if (!UIFrameBuffer::fill(display,&dim,UIFrameBuffer::Checkerboard)) {  // Fall back to U8g2 if the buffer cannot be accessed
+      display->setDrawColor(1);
+      for (uint16_t y=dim.top;y<dim.bottom;y+=16)
+        for (uint16_t x=dim.left;x<dim.right;x+=16)
+          display->drawXBMP(x,y,16,16,checkerboard_bits);
+    }
     return &dim;
   }
   else
@@ -37,7 +40,7 @@ void UICheckerboard::computePreferredSize(U8G2 *display,UISize *preferredSize) {
   preferredSize->set(&(this->preferredSize));
 }
 
-unsigned char UICheckerboard::checkerboard_bits[] = {
+const unsigned char UICheckerboard::checkerboard_bits[] PROGMEM = {
    0xaa, 0xaa, 0x55, 0x55, 0xaa, 0xaa, 0x55, 0x55, 0xaa, 0xaa, 0x55, 0x55,
    0xaa, 0xaa, 0x55, 0x55, 0xaa, 0xaa, 0x55, 0x55, 0xaa, 0xaa, 0x55, 0x55,
    0xaa, 0xaa, 0x55, 0x55, 0xaa, 0xaa, 0x55, 0x55 };
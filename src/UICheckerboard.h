@@ -32,7 +32,7 @@ class UICheckerboard : public UIWidget {
   private:
 
     /** The bit pattern to use for creating the checkerboard pattern. */
-    static unsigned char checkerboard_bits[];
+    static const unsigned char checkerboard_bits[] PROGMEM;
 
     /** Size of the currently rendered text. */
     UISize preferredSize;
@@ -25,22 +25,30 @@ void UIColumns::layout(U8G2* display,UIArea* dim) {
   UIWidget* widget=firstChild;
   while (widget && stamp.right<dim->right) {
     int requestedWidth=widget->preferredSize(display).width;
-    stamp.right=min(dim->right,(uint16_t)(stamp.right+(requestedWidth==UISize::MAX_LEN?extendingWidth:requestedWidth)));
-    widget->layout(display,&stamp);
+    stamp.right=min((int)dim->right,stamp.right+(requestedWidth==UISize::MAX_LEN?extendingWidth:requestedWidth));
+    layoutChild(display,widget,&stamp);
     widget=widget->next;
     stamp.left=stamp.right;
   }
+  // Widgets which do not fit anymore get an empty area
+  stamp.left=stamp.right;
+  while (widget) {
+    layoutChild(display,widget,&stamp);
+    widget=widget->next;
+  }
 }
 
 /* Preferred size of a columns group is computed by attaching the sub-widgets appropriately. */
 void UIColumns::computePreferredSize(U8G2 *display,UISize *preferredSize) {
+  extendingChildrenCount=0;
+  fixedWidth=0;
   UIWidget* elem=firstChild;
   while (elem) {
     UISize otherDim=elem->preferredSize(display);
     if (otherDim.width==UISize::MAX_LEN)
       extendingChildrenCount+=1;
     else
-      fixedWidth+=otherDim.width;
+      fixedWidth=UISize::max_len_or(fixedWidth+otherDim.width);
     preferredSize->cumulateWidthMaxHeight(&otherDim);
     elem=elem->next;
   }
@@ -46,7 +46,7 @@ class UIColumns: public UIWidgetGroup {
     uint8_t extendingChildrenCount;
 
     /** Sum of all fixed height preferences (not "as high as possible") of the sub-widgets. */
-    uint16_t fixedWidth;
+    UICoordinate fixedWidth;
 
 };
 
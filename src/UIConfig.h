@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// (C) 2023 Dirk Hillbrecht
+
+// Compile-time configuration of the UiUiUi library
+//
+// All settings can be overridden by defining the respective symbol
+// before this file is included, usually as a compiler flag,
+// e.g. "build_flags = -DUIUIUI_STATISTICS=1" in PlatformIO.
+
+#pragma once
+
+#include "Arduino.h"
+
+/** Collect render statistics in widgets and UIDisplay (1) or not (0, default).
+ *
+ * If disabled, statistics cost neither RAM nor CPU time, the according methods do not exist at all.
+ */
+#ifndef UIUIUI_STATISTICS
+#define UIUIUI_STATISTICS 0
+#endif
+
+/** Number of disjoint areas an UIAreaList can hold, at least 1.
+ *
+ * More areas keep distant changes apart more often, but each costs the size of an UIArea
+ * in every list, and UIDisplay keeps several lists. See UIAreaList.
+ */
+#ifndef UIUIUI_AREA_LIST_SIZE
+#define UIUIUI_AREA_LIST_SIZE 4
+#endif
+
+/** Number of text widths cached for all text lines together, 0 disables the cache.
+ *
+ * Each entry needs about 10 bytes of RAM. See UITextWidthCache.
+ */
+#ifndef UIUIUI_TEXT_WIDTH_CACHE_SIZE
+#define UIUIUI_TEXT_WIDTH_CACHE_SIZE 4
+#endif
+
+/** Number of updates an UIUpdateQueue can hold, must be a power of 2 up to 128.
+ *
+ * Each entry needs one byte plus three pointers plus UIUIUI_UPDATE_QUEUE_TEXT_SIZE bytes of RAM.
+ * See UIUpdateQueue.
+ */
+#ifndef UIUIUI_UPDATE_QUEUE_SIZE
+#define UIUIUI_UPDATE_QUEUE_SIZE 8
+#endif
+
+/** Maximum length of a text posted with UIUpdateQueue::copyText() including the terminating 0.
+ *
+ * Longer texts are cut. 0 removes copyText() and keeps the queue entries small.
+ */
+#ifndef UIUIUI_UPDATE_QUEUE_TEXT_SIZE
+#define UIUIUI_UPDATE_QUEUE_TEXT_SIZE 16
+#endif
+
+/** Compile UIThreadRenderWorker based on std::thread (1) or not (0, default).
+ *
+ * This is meant for tests on the host. Many microcontroller toolchains ship the headers
+ * of std::thread without an implementation, so it must be enabled explicitly. See UIRenderWorker.
+ */
+#ifndef UIUIUI_STD_THREAD
+#define UIUIUI_STD_THREAD 0
+#endif
+
+/** Compile UIFreeRTOSRenderWorker (1) or not (0).
+ *
+ * Defaults to 1 if FreeRTOS is available as on the ESP32. See UIRenderWorker.
+ */
+#ifndef UIUIUI_FREERTOS
+#if defined(__has_include)
+#if __has_include(<freertos/FreeRTOS.h>)
+#define UIUIUI_FREERTOS 1
+#endif
+#endif
+#endif
+#ifndef UIUIUI_FREERTOS
+#define UIUIUI_FREERTOS 0
+#endif
+
+/** Store coordinates and lengths in 8 bits (1) or in 16 bits (0, default).
+ *
+ * 8-bit coordinates halve UIPoint, UISize and UIArea and so all widgets containing them,
+ * and area computations become cheaper on 8-bit CPUs. The display must not be larger than
+ * 255 pixels in either direction then, UISize::MAX_LEN becomes 255. UIDisplay::init() refuses
+ * larger displays and returns false.
+ */
+#ifndef UIUIUI_COMPACT_COORDINATES
+#define UIUIUI_COMPACT_COORDINATES 0
+#endif
+
+/** Type of all coordinates and lengths on the display, see UIUIUI_COMPACT_COORDINATES. */
+#if UIUIUI_COMPACT_COORDINATES
+typedef uint8_t UICoordinate;
+#else
+typedef uint16_t UICoordinate;
+#endif
+
+// end of file
@@ -7,21 +7,36 @@
 #include <U8g2lib.h>
 
 #include "UIArea.h"
+#include "UIAreaList.h"
 #include "UIWidget.h"
 #include "UIDisplay.h"
 
 /* Setup the UIDisplay onto the given U8g2 instance and with the given root widget. */
 UIDisplay::UIDisplay(UIWidget* root):
-root(root), maxFirstUpdateTiles(0xffff), maxFollowUpdateTiles(0xffff) {
+root(root), layoutNeeded(false), maxFirstUpdateTiles(0xffff), maxFollowUpdateTiles(0xffff),
+maxFirstUpdateMicros(0), maxFollowUpdateMicros(0), minRenderMillis(0), coalesceMillis(0), lastRenderMillis(0), firstChangeMillis(0),
+renderingDeferred(false), deferredMillis(0), deferredAreas(nullptr), tileMicros16(0), transfer(nullptr), transferStartMicros(0), transferTileCount(0), forcePending(false), updateQueue(nullptr), renderWorker(nullptr),
+renderingNeededCallback(nullptr), updatePendingCallback(nullptr),
+backBuffer(nullptr), backBufferSize(0), backBufferPending(false),
+tileChecksums(nullptr), tileChecksumCount(0), tileChecksumsValid(false), tileChecksumsSyncing(false) {
   root->setParent(this);
 }
 
 /* Initialize the whole user interface, layout the widgets. */
-void UIDisplay::init(U8G2* display,bool enable,bool render) {
+bool UIDisplay::init(U8G2* display,bool enable,bool render) {
+
+  // 8-bit coordinates cannot describe larger displays, they would be truncated to some small size
+  if (display->getDisplayWidth()>UISize::MAX_LEN || display->getDisplayHeight()>UISize::MAX_LEN) {
+    enabled=false;
+    active=false;
+    return false;
+  }
 
   // trigger computation of the preferred sizes throughout the complete widget tree.
   // UIDisplay itself does not care about preferred sizes, it knows the size pf the physical
   // display and that's all that counts...
+  // A tree which has been layouted before computes those sizes again which have been invalidated since.
+  root->refreshPreferredSize(display);
   root->preferredSize(display);
 
   // Create the dimension of the actual physical display
@@ -29,6 +44,7 @@ void UIDisplay::init(U8G2* display,bool enable,bool render) {
 
   // Layout all components, this is done throughout the whole widget tree.
   root->layout(display,&fullscreen);
+  layoutNeeded=false;
 
   // Finally enable the display and perform initial rendering if requested
   active=true;
@@ -38,6 +54,7 @@ void UIDisplay::init(U8G2* display,bool enable,bool render) {
   }
   else if (render)
     this->render(display,true);
+  return true;
 }
 
 void UIDisplay::setUpdateTiles(uint16_t maxFirstUpdateTiles,uint16_t maxFollowUpdateTiles) {
@@ -45,6 +62,93 @@ void UIDisplay::setUpdateTiles(uint16_t maxFirstUpdateTiles,uint16_t maxFollowUp
   this->maxFollowUpdateTiles=maxFollowUpdateTiles;
 }
 
+void UIDisplay::setUpdateTime(uint32_t maxFirstUpdateMicros,uint32_t maxFollowUpdateMicros) {
+  this->maxFirstUpdateMicros=maxFirstUpdateMicros;
+  this->maxFollowUpdateMicros=maxFollowUpdateMicros;
+}
+
+void UIDisplay::setBackBuffer(uint8_t* buffer,uint16_t size) {
+  this->backBuffer=buffer;
+  this->backBufferSize=size;
+  this->backBufferPending=false;
+  this->backUpdateTiles.clear();
+}
+
+void UIDisplay::setTransfer(UITransfer* transfer) {
+  this->transfer=transfer;
+}
+
+void UIDisplay::setUpdateQueue(UIUpdateQueue* queue) {
+  updateQueue=queue;
+  if (updateQueue)
+    updateQueue->setRenderWorker(renderWorker);
+}
+
+void UIDisplay::startRenderWorker(U8G2* display,UIRenderWorker* worker) {
+  renderWorker=worker;
+  if (updateQueue)
+    updateQueue->setRenderWorker(worker);
+  worker->start(this,display);
+}
+
+void UIDisplay::setRenderCallbacks(UIDisplayCallback renderingNeeded,UIDisplayCallback updatePending) {
+  renderingNeededCallback=renderingNeeded;
+  updatePendingCallback=updatePending;
+}
+
+bool UIDisplay::isRenderingNeeded() {
+  return renderingNeeded || renderingDeferred || layoutNeeded || (updateQueue && !updateQueue->isEmpty());
+}
+
+void UIDisplay::signalRenderingNeeded() {
+  if (renderingNeededCallback && enabled && active)
+    renderingNeededCallback(this);
+}
+
+void UIDisplay::setRenderInterval(uint16_t minRenderMillis,uint16_t coalesceMillis) {
+  this->minRenderMillis=minRenderMillis;
+  this->coalesceMillis=coalesceMillis;
+}
+
+uint32_t UIDisplay::getRenderDelay() {
+  if (!enabled || !active || !(renderingNeeded || renderingDeferred))
+    return 0;
+  uint32_t now=millis();
+  uint32_t due=(renderingNeeded?firstChangeMillis+coalesceMillis:deferredMillis);
+  if ((int32_t)(lastRenderMillis+minRenderMillis-due)>0)
+    due=lastRenderMillis+minRenderMillis;
+  int32_t delay=(int32_t)(due-now);
+  return (delay>0?delay:1);  // 1 if due already, so that 0 always means "nothing to do"
+}
+
+bool UIDisplay::isRenderingDue() {
+  uint32_t now=millis();
+  if (renderingDeferred && (int32_t)(now-deferredMillis)>=0) {  // deferred widgets are due, collection time is over
+    renderingDeferred=false;
+    if (!renderingNeeded) {
+      renderingNeeded=true;
+      firstChangeMillis=now-coalesceMillis;
+    }
+  }
+  return renderingNeeded && now-firstChangeMillis>=coalesceMillis && now-lastRenderMillis>=minRenderMillis;
+}
+
+void UIDisplay::startRendering() {
+  renderingNeeded=false;
+  lastRenderMillis=millis();
+}
+
+uint16_t UIDisplay::getTileMicros() {
+  return (tileMicros16+8)>>4;
+}
+
+void UIDisplay::setTileChecksums(uint16_t* checksums,uint16_t count) {
+  this->tileChecksums=checksums;
+  this->tileChecksumCount=count;
+  this->tileChecksumsValid=false;  // Nothing is known about the current display content until next forced rendering
+  this->tileChecksumsSyncing=false;
+}
+
 /** Enable the UI: It presents itself on screen, display is turned on. */
 void UIDisplay::enable(U8G2* display,bool render,bool force) {
   if (!enabled) {
@@ -52,6 +156,8 @@ void UIDisplay::enable(U8G2* display,bool render,bool force) {
     enabled=true;
     if (render)
       this->render(display,force);
+    else if (isRenderingNeeded())
+      signalRenderingNeeded();
   }
 }
 
@@ -70,65 +176,496 @@ void UIDisplay::deactivate() {
 
 /** Activates the UI: Rendering will be performed if render() is called. */
 void UIDisplay::activate() {
-  active=true;
+  if (!active) {
+    active=true;
+    if (isRenderingNeeded())
+      signalRenderingNeeded();
+  }
 }
 
 /** Called by the root widget to indicate that rendering must be performed. */
 void UIDisplay::childNeedsRendering(UIWidget *child) {
+  bool wasNeeded=renderingNeeded || layoutNeeded;
+  if (!renderingNeeded)
+    firstChangeMillis=millis();
   renderingNeeded=true;
+  if (!wasNeeded)
+    signalRenderingNeeded();
+  if (renderWorker)
+    renderWorker->wake();
+}
+
+/** Called by the root widget if some widget wants to be rendered after the given time. */
+void UIDisplay::childDefersRendering(UIWidget *child,UIArea *area,uint16_t millis) {
+  uint32_t due=::millis()+millis;
+  if (!renderingDeferred || (int32_t)(due-deferredMillis)<0)
+    deferredMillis=due;
+  renderingDeferred=true;
+  if (deferredAreas)  // page buffer dry run: the display must know where deferred content is
+    deferredAreas->add(area);
+}
+
+/** Called by the root widget to indicate that the layout must be updated. */
+void UIDisplay::childNeedsLayout(UIWidget *child) {
+  bool wasNeeded=renderingNeeded || layoutNeeded;
+  layoutNeeded=true;
+  if (!wasNeeded)
+    signalRenderingNeeded();
+  if (renderWorker)
+    renderWorker->wake();
+}
+
+void UIDisplay::updateLayout(U8G2 *display) {
+  layoutNeeded=false;
+  root->refreshPreferredSize(display);
+  UIArea fullscreen=UIArea(0,0,display->getDisplayWidth(),display->getDisplayHeight());
+  root->layout(display,&fullscreen);
 }
 
 void UIDisplay::doUpdateTiles(U8G2 *display,uint16_t maxUpdateTiles) {
-  uint16_t updateWidth=updateTiles.right-updateTiles.left;
-  uint16_t updateHeight=updateTiles.bottom-updateTiles.top;
-  if (maxUpdateTiles>=updateWidth*updateHeight) {
-    // If maximum number of update tiles allows to update the whole area, just do it.
-    display->updateDisplayArea(updateTiles.left,updateTiles.top,updateWidth,updateHeight);
-    if (furtherUpdateTiles.hasArea()) {
-      updateTiles.set(&furtherUpdateTiles);
-      furtherUpdateTiles.clear();
+  while (maxUpdateTiles>0 && updateTiles.hasArea()) {
+    if (isTransferRunning(display))  // one transfer per call, the rest is sent by the next render() calls
+      return;
+    uint16_t updateWidth=updateTiles.right-updateTiles.left;
+    uint16_t updateHeight=updateTiles.bottom-updateTiles.top;
+    if (transfer && areTileChecksumsUsable(display)) {
+      // Each run of changed tiles is a transfer of its own, so go through the top row run by run
+      uint8_t end=sendChangedRun(display,updateTiles.left,updateTiles.top,min(updateWidth,maxUpdateTiles));
+      maxUpdateTiles-=end-updateTiles.left;
+      if (end<updateTiles.right) {  // Keep the rest of the row, the rows below come later
+        UIArea below=UIArea(&updateTiles);
+        below.top++;
+        if (below.hasArea()) {
+          if (furtherUpdateTiles.hasArea())
+            pendingUpdateTiles.add(&below);
+          else
+            furtherUpdateTiles.set(&below);
+        }
+        updateTiles.left=end;
+        updateTiles.bottom=updateTiles.top+1;
+      }
+      else {
+        updateTiles.top++;
+        if (!updateTiles.hasArea())
+          takeNextUpdateTiles();
+      }
     }
-    else
-      updateTiles.clear();
-  }
-  else {
-    if (updateWidth>maxUpdateTiles && !furtherUpdateTiles.hasArea()) {
-      furtherUpdateTiles.set(&updateTiles);
-      updateTiles.right=updateTiles.left+maxUpdateTiles;
-      furtherUpdateTiles.left=updateTiles.right;
-      updateWidth=maxUpdateTiles;
+    else if (maxUpdateTiles>=updateWidth*updateHeight) {
+      // If maximum number of update tiles allows to update the whole area, just do it
+      // and continue with the next area if there are tiles left.
+      sendDisplayArea(display,updateTiles.left,updateTiles.top,updateWidth,updateHeight);
+      maxUpdateTiles-=updateWidth*updateHeight;
+      takeNextUpdateTiles();
     }
-    uint16_t updateRows=maxUpdateTiles/updateWidth;
-    display->updateDisplayArea(updateTiles.left,updateTiles.top,updateWidth,updateRows);
-    updateTiles.top+=updateRows;
-    if (!updateTiles.hasArea() && furtherUpdateTiles.hasArea()) {
-      updateTiles.set(&furtherUpdateTiles);
-      furtherUpdateTiles.clear();
+    else {
+      if (updateWidth>maxUpdateTiles) {
+        // Split area: Left part is updated now, right part later
+        UIArea rightPart=UIArea(&updateTiles);
+        updateTiles.right=updateTiles.left+maxUpdateTiles;
+        rightPart.left=updateTiles.right;
+        if (furtherUpdateTiles.hasArea())
+          pendingUpdateTiles.add(&rightPart);
+        else
+          furtherUpdateTiles.set(&rightPart);
+        updateWidth=maxUpdateTiles;
+      }
+      uint16_t updateRows=maxUpdateTiles/updateWidth;
+      sendDisplayArea(display,updateTiles.left,updateTiles.top,updateWidth,updateRows);
+      updateTiles.top+=updateRows;
+      if (!updateTiles.hasArea())
+        takeNextUpdateTiles();
+      maxUpdateTiles=0;
+    }
+  }
+}
+
+void UIDisplay::takeNextUpdateTiles() {
+  if (furtherUpdateTiles.hasArea()) {
+    updateTiles.set(&furtherUpdateTiles);
+    furtherUpdateTiles.clear();
+  }
+  else
+    pendingUpdateTiles.take(&updateTiles);
+}
+
+uint16_t UIDisplay::tilesWithinTime(uint16_t maxTiles,uint32_t maxMicros) {
+  if (maxMicros==0)  // no time budget, only the tile count counts
+    return maxTiles;
+  if (tileMicros16==0)  // not calibrated yet: send one tile and measure
+    return 1;
+  uint32_t tiles=(maxMicros<<4)/tileMicros16;
+  return (tiles<1?1:(tiles>maxTiles?maxTiles:tiles));
+}
+
+void UIDisplay::calibrateTileMicros(uint32_t micros,uint16_t tiles) {
+  // Running average in 1/16 microseconds
+  uint32_t sample=(micros<<4)/tiles;
+  tileMicros16=(tileMicros16==0?sample:(3*tileMicros16+sample)>>2);
+}
+
+void UIDisplay::sendDisplayArea(U8G2 *display,uint8_t left,uint8_t top,uint8_t width,uint8_t height) {
+  if (!areTileChecksumsUsable(display)) {
+    transferTiles(display,left,top,width,height);
+    return;
+  }
+  // Walk through the rows and send consecutive runs of changed tiles
+  for (uint8_t y=top;y<top+height;y++) {
+    uint8_t runStart=left;
+    for (uint8_t x=left;x<left+width;x++) {
+      if (!updateTileChecksum(display,x,y)) {  // unchanged: send run before this tile
+        if (x>runStart)
+          transferTiles(display,runStart,y,x-runStart,1);
+        runStart=x+1;
+      }
     }
+    if (left+width>runStart)
+      transferTiles(display,runStart,y,left+width-runStart,1);
+  }
+}
+
+uint8_t UIDisplay::sendChangedRun(U8G2 *display,uint8_t left,uint8_t y,uint8_t width) {
+  uint8_t end=left+width;
+  uint8_t x=left;
+  while (x<end && !updateTileChecksum(display,x,y))
+    x++;
+  if (x==end)
+    return end;
+  uint8_t runStart=x++;  // each checksum is updated only once, so the first changed tile is not checked again
+  while (x<end && updateTileChecksum(display,x,y))
+    x++;
+  transferTiles(display,runStart,y,x-runStart,1);
+  return (x<end?x+1:end);  // the unchanged tile ending the run is done as well
+}
+
+bool UIDisplay::areTileChecksumsUsable(U8G2 *display) {
+  return tileChecksums && tileChecksumCount>=display->getBufferTileWidth()*display->getBufferTileHeight();
+}
+
+bool UIDisplay::updateTileChecksum(U8G2 *display,uint8_t x,uint8_t y) {
+  uint16_t checksum=computeTileChecksum(display,x,y);
+  uint16_t *stored=&tileChecksums[y*display->getBufferTileWidth()+x];
+  bool changed=!(tileChecksumsValid && *stored==checksum);
+  *stored=checksum;
+#if UIUIUI_STATISTICS
+  if (!changed)
+    statistics.tilesSkipped++;
+#endif
+  return changed;
+}
+
+void UIDisplay::transferTiles(U8G2 *display,uint8_t left,uint8_t top,uint8_t width,uint8_t height) {
+  uint32_t start=micros();
+  if (transfer) {  // callers make sure that no other transfer is running, its end is measured by isTransferRunning()
+    UIArea tiles=UIArea(left,top,left+width,top+height);
+    transfer->startTransfer(display,display->getBufferPtr(),&tiles);
+    transferStartMicros=start;
+    transferTileCount=width*height;
+  }
+  else {
+    display->updateDisplayArea(left,top,width,height);
+    calibrateTileMicros(micros()-start,width*height);
+  }
+#if UIUIUI_STATISTICS
+  statistics.transferMicros+=micros()-start;
+  statistics.transfers++;
+  statistics.tilesSent+=width*height;
+  statistics.bytesSent+=8*width*height;
+#endif
+}
+
+bool UIDisplay::isTransferRunning(U8G2 *display) {
+  if (!transfer)
+    return false;
+  if (transfer->isTransferring(display))
+    return true;
+  if (transferTileCount>0) {  // first call after the end of the transfer: this is as exact as the polling
+    calibrateTileMicros(micros()-transferStartMicros,transferTileCount);
+    transferTileCount=0;
   }
+  return false;
+}
+
+uint16_t UIDisplay::computeTileChecksum(U8G2 *display,uint8_t x,uint8_t y) {
+  // The 8 bytes of a tile are consecutive in vertical buffer layout (the usual one),
+  // but one byte per pixel row apart in horizontal buffer layout.
+  uint8_t tileWidth=display->getBufferTileWidth();
+  uint8_t *ptr=display->getBufferPtr();
+  uint16_t step;
+  if (display->getU8g2()->ll_hvline==u8g2_ll_hvline_horizontal_right_lsb) {
+    ptr+=(uint16_t)y*8*tileWidth+x;
+    step=tileWidth;
+  }
+  else {
+    ptr+=((uint16_t)y*tileWidth+x)*8;
+    step=1;
+  }
+  // CRC-16-CCITT detects any change of up to three pixels within the tile for sure
+  uint16_t crc=0xffff;
+  for (uint8_t i=0;i<8;i++) {
+    crc^=((uint16_t)*ptr)<<8;
+    for (uint8_t bit=0;bit<8;bit++)
+      crc=(crc&0x8000?(crc<<1)^0x1021:crc<<1);
+    ptr+=step;
+  }
+  return crc;
 }
 
 /* Render the interface, update everything that has changed since the last render() call. */
 void UIDisplay::render(U8G2 *display,bool force) {
+  doRender(display,force);
+  if (!enabled)
+    return;
+  // Tell the sketch whether it has to call render() again
+  if (updatePendingCallback && isUpdatingDisplay(display))
+    updatePendingCallback(this);
+  else if (isRenderingNeeded())
+    signalRenderingNeeded();
+}
+
+void UIDisplay::doRender(U8G2 *display,bool force) {
   // Do not do anything if display is not enabled
   if (!enabled)
     return;
-  if (!force && updateTiles.hasArea())  // updating display tiles takes precedence over (non-forced) rendering
-    doUpdateTiles(display,maxFollowUpdateTiles);
-  else if (active && (force || renderingNeeded)) { // start rendering only if active and some need for rendering
-    renderingNeeded=false;
-    UIArea rendered=UIArea();
-    rendered.uniteWith(root->render(display,force));
-    if (rendered.hasArea()) {
-	  computeTileAreaFromPixelArea(display,&rendered,&updateTiles);
-      if (maxFirstUpdateTiles>0)
-        doUpdateTiles(display,maxFirstUpdateTiles);
+  if (updateQueue)  // widgets are changed here so that nothing changes while rendering
+    updateQueue->apply();
+  if (layoutNeeded && active)
+    updateLayout(display);
+  if (display->getBufferTileHeight()<display->getU8x8()->display_info->tile_height) {  // page buffer: own rendering scheme
+    renderPages(display,force);
+    return;
+  }
+  if (isTransferRunning(display)) {  // tiles in flight must not be rendered over
+    if (force)  // rendered by the first call after the transfer
+      forcePending=true;
+    else if (active && isRenderingDue() && isBackBufferUsable(display))
+      renderBackBuffer(display);
+    return;
+  }
+  if (forcePending) {
+    force=true;
+    forcePending=false;
+  }
+  if (backBufferPending && (force || !updateTiles.hasArea()))  // front buffer is sent (or obsolete), continue with back buffer
+    swapBuffers(display);
+  uint32_t start=micros();
+#if UIUIUI_STATISTICS
+  bool wasUpdating=updateTiles.hasArea();
+  statistics.renderCalls++;
+#endif
+  if (!force && updateTiles.hasArea()) { // updating display tiles takes precedence over (non-forced) rendering
+#if UIUIUI_STATISTICS
+    statistics.deferredUpdateCycles++;
+#endif
+    doUpdateTiles(display,tilesWithinTime(maxFollowUpdateTiles,maxFollowUpdateMicros));
+    if (active && isRenderingDue() && isBackBufferUsable(display))  // render changes while the front buffer is sent
+      renderBackBuffer(display);
+  }
+  else if (active && (force || isRenderingDue())) { // start rendering only if active and some need for rendering
+#if UIUIUI_STATISTICS
+    statistics.renderCycles++;
+#endif
+    startRendering();
+    UIAreaList rendered=UIAreaList();
+    root->renderAreas(display,force,&rendered);
+    if (force) {
+      // Forced rendering updates the whole display, even parts no widget has reported
+      UIArea fullscreen=UIArea(0,0,display->getDisplayWidth(),display->getDisplayHeight());
+      rendered.clear();
+      rendered.add(&fullscreen);
+      tileChecksumsValid=false;
+      tileChecksumsSyncing=true;
+    }
+    if (!rendered.isEmpty()) {
+#if UIUIUI_STATISTICS
+      if (!wasUpdating) {  // latency is measured from the first rendering to the last sent tile
+        updateStartMicros=start;
+        updateLatencyMeasuring=true;
+      }
+#endif
+      // Tiles still waiting for their update are merged with the newly rendered ones
+      pendingUpdateTiles.add(&updateTiles);
+      pendingUpdateTiles.add(&furtherUpdateTiles);
+      furtherUpdateTiles.clear();
+      UIArea tiles=UIArea();
+      for (uint8_t i=0;i<rendered.getCount();i++) {
+        computeTileAreaFromPixelArea(display,rendered.get(i),&tiles);
+        pendingUpdateTiles.add(&tiles);
+      }
+      pendingUpdateTiles.take(&updateTiles);
+      // With a time budget, the time already spent for rendering is taken from it
+      uint32_t elapsed=micros()-start;
+      if (maxFirstUpdateTiles>0 && (maxFirstUpdateMicros==0 || elapsed<maxFirstUpdateMicros))
+        doUpdateTiles(display,tilesWithinTime(maxFirstUpdateTiles,(maxFirstUpdateMicros==0?0:maxFirstUpdateMicros-elapsed)));
     }
   }
+  if (tileChecksumsSyncing && !updateTiles.hasArea()) {  // forced rendering sent, checksums represent the display content
+    tileChecksumsValid=true;
+    tileChecksumsSyncing=false;
+  }
+#if UIUIUI_STATISTICS
+  uint32_t end=micros();
+  if (end-start>statistics.maxRenderMicros)
+    statistics.maxRenderMicros=end-start;
+  if (updateLatencyMeasuring && !updateTiles.hasArea()) {
+    updateLatencyMeasuring=false;
+    if (end-updateStartMicros>statistics.maxUpdateLatencyMicros)
+      statistics.maxUpdateLatencyMicros=end-updateStartMicros;
+  }
+#endif
+}
+
+bool UIDisplay::isUpdatingDisplay(U8G2 *display) {
+  return updateTiles.hasArea() || backBufferPending || forcePending || (display && isTransferRunning(display));
+}
+
+void UIDisplay::renderPages(U8G2 *display,bool force) {
+  if (!active || !(force || isRenderingDue()))
+    return;
+#if UIUIUI_STATISTICS
+  uint32_t start=micros();
+  statistics.renderCalls++;
+  statistics.renderCycles++;
+#endif
+  startRendering();
+  UIAreaList rendered=UIAreaList();
+  UIAreaList deferred=UIAreaList();
+  if (force) {
+    UIArea fullscreen=UIArea(0,0,display->getDisplayWidth(),display->getDisplayHeight());
+    rendered.add(&fullscreen);
+  }
+  else {  // Dry run: Only find out what has changed, the drawing itself is discarded
+    deferredAreas=&deferred;
+    root->renderAreas(display,false,&rendered);
+    deferredAreas=nullptr;
+  }
+  UIAreaList dirtyTiles=UIAreaList();
+  UIArea tiles=UIArea();
+  for (uint8_t i=0;i<rendered.getCount();i++) {
+    computeTileAreaFromPixelArea(display,rendered.get(i),&tiles);
+    dirtyTiles.add(&tiles);
+  }
+  if (dirtyTiles.isEmpty())
+    return;
+  addDeferredTiles(display,&dirtyTiles,&deferred);
+  UIArea enclosure=dirtyTiles.getEnclosure();
+  uint8_t pageHeight=display->getBufferTileHeight();
+  uint8_t displayHeight=display->getU8x8()->display_info->tile_height;
+  for (uint8_t row=enclosure.top-enclosure.top%pageHeight;row<enclosure.bottom;row+=pageHeight) {
+    // Collect the dirty tiles within this page
+    UIArea page=UIArea(0,row,display->getBufferTileWidth(),min(row+pageHeight,(int)displayHeight));
+    UIArea pageTiles=UIArea();
+    for (uint8_t i=0;i<dirtyTiles.getCount();i++)
+      if (dirtyTiles.get(i)->overlaps(&page))
+        pageTiles.uniteWith(dirtyTiles.get(i));
+    if (!pageTiles.hasArea())
+      continue;
+    pageTiles.top=max(pageTiles.top,page.top);
+    pageTiles.bottom=min(pageTiles.bottom,page.bottom);
+    // Render everything on this page, U8g2 clips the drawing to it
+    display->setBufferCurrTileRow(row);
+    display->clearBuffer();
+    UIAreaList pageRendered=UIAreaList();
+    root->renderAreas(display,true,&pageRendered);
+    sendPageTiles(display,&pageTiles);
+  }
+#if UIUIUI_STATISTICS
+  uint32_t duration=micros()-start;
+  if (duration>statistics.maxRenderMicros)
+    statistics.maxRenderMicros=duration;
+  if (duration>statistics.maxUpdateLatencyMicros)
+    statistics.maxUpdateLatencyMicros=duration;
+#endif
+}
+
+void UIDisplay::addDeferredTiles(U8G2 *display,UIAreaList *dirtyTiles,UIAreaList *deferred) {
+  uint8_t pageHeight=display->getBufferTileHeight();
+  UIArea deferredTiles[UIAreaList::CAPACITY];
+  uint8_t count=deferred->getCount();
+  for (uint8_t i=0;i<count;i++)
+    computeTileAreaFromPixelArea(display,deferred->get(i),&deferredTiles[i]);
+  // Adding the tiles of one widget can touch further pages and so further deferred widgets
+  bool added=true;
+  while (added) {
+    added=false;
+    for (uint8_t i=0;i<count;i++) {
+      if (!deferredTiles[i].hasArea())
+        continue;
+      for (uint8_t j=0;j<dirtyTiles->getCount();j++) {
+        UIArea* dirty=dirtyTiles->get(j);
+        uint8_t pageTop=dirty->top-dirty->top%pageHeight;
+        uint8_t pageBottom=(dirty->bottom+pageHeight-1)/pageHeight*pageHeight;
+        if (deferredTiles[i].top<pageBottom && pageTop<deferredTiles[i].bottom) {
+          dirtyTiles->add(&deferredTiles[i]);
+          deferredTiles[i].clear();
+          added=true;
+          break;
+        }
+      }
+    }
+  }
+}
+
+void UIDisplay::sendPageTiles(U8G2 *display,UIArea *tiles) {
+  uint8_t tileWidth=display->getBufferTileWidth();
+  uint8_t left=tiles->left,width=tiles->right-tiles->left;
+  if (display->getU8g2()->ll_hvline==u8g2_ll_hvline_horizontal_right_lsb) {  // tiles are not consecutive, send whole rows
+    left=0;
+    width=tileWidth;
+  }
+  uint8_t currRow=display->getBufferCurrTileRow();
+  for (uint8_t y=tiles->top;y<tiles->bottom;y++) {
+#if UIUIUI_STATISTICS
+    uint32_t start=micros();
+#endif
+    u8x8_DrawTile(display->getU8x8(),left,y,width,display->getBufferPtr()+((uint16_t)(y-currRow)*tileWidth+left)*8);
+#if UIUIUI_STATISTICS
+    statistics.transferMicros+=micros()-start;
+    statistics.transfers++;
+    statistics.tilesSent+=width;
+    statistics.bytesSent+=8*width;
+#endif
+  }
+}
+
+bool UIDisplay::isBackBufferUsable(U8G2 *display) {
+  return backBuffer && backBufferSize>=8*display->getBufferTileWidth()*display->getBufferTileHeight();
+}
+
+void UIDisplay::renderBackBuffer(U8G2 *display) {
+  u8g2_t *u8g2=display->getU8g2();
+  uint8_t *frontBuffer=u8g2->tile_buf_ptr;
+  if (!backBufferPending) {  // back buffer starts with the content of the front buffer
+    memcpy(backBuffer,frontBuffer,8*display->getBufferTileWidth()*display->getBufferTileHeight());
+    backBufferPending=true;
+  }
+#if UIUIUI_STATISTICS
+  statistics.renderCycles++;
+#endif
+  startRendering();
+  UIAreaList rendered=UIAreaList();
+  u8g2->tile_buf_ptr=backBuffer;
+  root->renderAreas(display,false,&rendered);
+  u8g2->tile_buf_ptr=frontBuffer;
+  UIArea tiles=UIArea();
+  for (uint8_t i=0;i<rendered.getCount();i++) {
+    computeTileAreaFromPixelArea(display,rendered.get(i),&tiles);
+    backUpdateTiles.add(&tiles);
+  }
 }
 
-bool UIDisplay::isUpdatingDisplay() {
-  return updateTiles.hasArea();
+void UIDisplay::swapBuffers(U8G2 *display) {
+  u8g2_t *u8g2=display->getU8g2();
+  uint8_t *frontBuffer=u8g2->tile_buf_ptr;
+  u8g2->tile_buf_ptr=backBuffer;
+  backBuffer=frontBuffer;
+  backBufferPending=false;
+  // Tiles rendered into the back buffer are sent now
+  pendingUpdateTiles.add(&updateTiles);
+  pendingUpdateTiles.add(&furtherUpdateTiles);
+  furtherUpdateTiles.clear();
+  pendingUpdateTiles.addAll(&backUpdateTiles);
+  backUpdateTiles.clear();
+  pendingUpdateTiles.take(&updateTiles);
 }
 
 void UIDisplay::computeTileAreaFromPixelArea(U8G2 *display, UIArea * pixelArea, UIArea * tileArea)
@@ -159,9 +696,9 @@ void UIDisplay::computeTileAreaFromPixelArea(U8G2 *display, UIArea * pixelArea,
   else if(display->getU8g2()->cb == U8G2_R3)//top right of pixel area is bottom right of screen
   {
   	tileArea->set(((                             pixelArea->top)     >>3)&0xff,
-			      ((display->getDisplayWidth() - pixelArea->left)    >>3)&0xff,
+			      ((display->getDisplayWidth() - pixelArea->right)   >>3)&0xff,
 			      ((                             pixelArea->bottom+7)>>3)&0xff,
-			      ((display->getDisplayWidth() - pixelArea->right+7) >>3)&0xff);
+			      ((display->getDisplayWidth() - pixelArea->left+7)  >>3)&0xff);
   }
   else//Should never happen. just update the whole screen.
   {
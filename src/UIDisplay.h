@@ -6,10 +6,21 @@
 #include "Arduino.h"
 #include <U8g2lib.h>
 
+#include "UIConfig.h"
 #include "UIArea.h"
+#include "UIAreaList.h"
+#include "UIStatistics.h"
+#include "UITransfer.h"
+#include "UIUpdateQueue.h"
+#include "UIRenderWorker.h"
 #include "UIWidget.h"
 #include "UIParent.h"
 
+class UIDisplay;
+
+/** Function called by UIDisplay to inform the sketch, see UIDisplay::setRenderCallbacks(). */
+typedef void (*UIDisplayCallback)(UIDisplay* display);
+
 /** Representation of the display onto which UiUiUi renders its user interface.
  *
  * This is always the topmost class of a UiUiUi interface.
@@ -18,7 +29,9 @@
  * directly if anything has to be rendered at all.
  *
  * UIDisplay converts any actual rendered area into tiles and sends only the changed tiles
- * to the display. It is even possible to restrict the number of tiles sent at once - in this case,
+ * to the display. Changed areas are kept apart as long as possible (see UIAreaList), so that
+ * changes in distant parts of the display do not lead to an update of everything in between.
+ * It is even possible to restrict the number of tiles sent at once - in this case,
  * render() must be called regulary by some background task.
  */
 class UIDisplay: public UIParent {
@@ -54,8 +67,10 @@ class UIDisplay: public UIParent {
      * @param display U8g2 display to work on
      * @param enable If true, explicitly enables the display, false if not. Default is true.
      * @param render If true, performs initial rendering, otherwise not. Default is true.
+     * @return false if the display is larger than UISize::MAX_LEN in either direction,
+     *   which only happens with UIUIUI_COMPACT_COORDINATES. Nothing is initialized and rendered then.
      */
-    void init(U8G2* display,bool enable=true,bool render=true);
+    bool init(U8G2* display,bool enable=true,bool render=true);
 
     /** Sets or changes the number of tiles to be sent to the display in one chunk.
      *
@@ -74,6 +89,162 @@ class UIDisplay: public UIParent {
      */
     void setUpdateTiles(uint16_t maxFirstUpdateTiles=0xffff,uint16_t maxFollowUpdateTiles=0xffff);
 
+    /** Sets or changes the time in microseconds which may be spent for sending tiles in one render() call.
+     *
+     * This is an alternative to setUpdateTiles() if the same interface runs on displays with different
+     * bus speeds. UIDisplay measures the time needed per tile while sending and derives the number
+     * of tiles which fit into the given time from it. Until the first measurement, only one tile is sent.
+     * At least one tile is always sent, the tile counts of setUpdateTiles() still are an upper limit.
+     *
+     * The time budget for updates together with rendering is reduced by the time the rendering
+     * itself took, so maxFirstUpdateMicros is roughly the maximum duration of the whole render() call.
+     *
+     * If this method is not called or if it is called without parameters, there is no time limit.
+     *
+     * @param maxFirstUpdateMicros Maximum time for rendering and updating tiles together, 0 for unlimited
+     * @param maxFollowUpdateMicros Maximum time for updating tiles if no rendering happens, 0 for unlimited
+     */
+    void setUpdateTime(uint32_t maxFirstUpdateMicros=0,uint32_t maxFollowUpdateMicros=0);
+
+    /** Sets or changes how often the interface is rendered at most and how long changes are collected.
+     *
+     * Widgets may change much more often than a display on a slow bus can show it, e.g. a text line
+     * showing a sensor value which is updated at 50 Hz. Normally, each render() call renders the
+     * changes and sends their tiles. With these limits, render() holds back non-forced rendering:
+     *
+     * * After the first change, it waits for coalesceMillis, so that all changes within this window
+     *   are rendered together and sent in one transfer.
+     * * It renders at most once every minRenderMillis, i.e. with at most 1000/minRenderMillis frames per second.
+     *
+     * Sending of already rendered tiles is not affected. Call render() regularly or schedule it
+     * after getRenderDelay(), a render worker does the latter by itself.
+     * If this method is not called or if it is called without parameters, changes are rendered immediately.
+     *
+     * @param minRenderMillis Minimum time between the start of two renderings, 0 for unlimited
+     * @param coalesceMillis Time to collect changes after the first one before rendering, 0 for none
+     */
+    void setRenderInterval(uint16_t minRenderMillis=0,uint16_t coalesceMillis=0);
+
+    /** Return the time in milliseconds after which render() will render held back changes.
+     *
+     * Returns 0 if no changes are waiting, at least 1 otherwise. Changes are held back by
+     * setRenderInterval() or by widgets with a minimum update interval like UITextLine::setMinUpdateInterval().
+     */
+    uint32_t getRenderDelay();
+
+    /** Return the currently measured time in microseconds to send one tile to the display, 0 if not yet known.
+     *
+     * Only tiles actually sent are measured, not those skipped due to tile checksums. With a transfer,
+     * the time is taken from its start to the first render() call which sees that it has ended.
+     */
+    uint16_t getTileMicros();
+
+    /** Sets or resets a non-blocking transfer of tiles to the display.
+     *
+     * If a transfer is set, tiles are not sent by U8G2::updateDisplayArea() but handed to the transfer.
+     * render() returns immediately as long as a transfer is running, so the sketch can do other work meanwhile.
+     * Neither rendering nor further transfers take place before the running transfer has finished.
+     * A forced rendering is done by the first render() call after the transfer.
+     *
+     * Each render() call starts at most one transfer. If more areas or, with tile checksums, more runs
+     * of changed tiles are waiting, they are sent by the following calls, as long as isUpdatingDisplay()
+     * returns true. UIDisplay never waits for a transfer.
+     *
+     * If this method is not called or if it is called without parameters, tiles are sent synchronously.
+     *
+     * @param transfer The transfer implementation to use, nullptr to send tiles synchronously.
+     */
+    void setTransfer(UITransfer* transfer=nullptr);
+
+    /** Sets or resets a queue of widget updates to be applied at the beginning of each render() call.
+     *
+     * Interrupts and other tasks post their updates into the queue instead of changing
+     * the widgets directly, so they never interfere with a running render() call. See UIUpdateQueue.
+     *
+     * @param queue The first of the chained update queues, nullptr if widgets are only changed by the rendering task itself.
+     */
+    void setUpdateQueue(UIUpdateQueue* queue=nullptr);
+
+    /** Starts rendering the interface on a dedicated task instead of by calls to render().
+     *
+     * The worker waits until a widget signals a change or an update is posted into the update queue,
+     * then it calls render() until all tiles are sent. Call this once after init() and do not call
+     * render() yourself afterwards. From now on, only the worker may touch the widgets.
+     * Other tasks and interrupts post their changes with an UIUpdateQueue, see setUpdateQueue().
+     *
+     * @param display U8g2 display to render on
+     * @param worker The render worker, e.g. UIFreeRTOSRenderWorker or UIThreadRenderWorker
+     */
+    void startRenderWorker(U8G2* display,UIRenderWorker* worker);
+
+    /** Sets or resets functions which tell the sketch when render() must be called.
+     *
+     * Instead of calling render() at a fixed rate, a sketch can schedule one render() call
+     * whenever it is told to and sleep in between:
+     *
+     * * renderingNeeded is called when the interface changes while no rendering was pending,
+     *   i.e. once per change which makes the display outdated. It is also called at the end of
+     *   render() if further changes are waiting, and on activate() and enable() if changes have been made meanwhile.
+     * * updatePending is called at the end of each render() call which leaves tiles to be sent,
+     *   e.g. because of setUpdateTiles() or a running transfer. Call render() again soon then.
+     *
+     * The functions are called from within widget setters and render(), so they should only
+     * schedule the call to render(), not call it themselves. Updates posted into an UIUpdateQueue
+     * do not call them, use a render worker or query isRenderingNeeded() for these.
+     * If rendering is held back by setRenderInterval(), schedule the call after getRenderDelay().
+     *
+     * @param renderingNeeded Function called when rendering becomes necessary, nullptr for none
+     * @param updatePending Function called when tiles are left for a further render() call, nullptr for none
+     */
+    void setRenderCallbacks(UIDisplayCallback renderingNeeded=nullptr,UIDisplayCallback updatePending=nullptr);
+
+    /** Return whether some change of the interface waits for rendering.
+     *
+     * This includes layout changes and updates waiting in the update queue. Tiles which have been rendered
+     * but are not yet sent are not included, see isUpdatingDisplay() for them.
+     */
+    bool isRenderingNeeded();
+
+    /** Sets or resets a back buffer so that rendering and sending tiles can overlap.
+     *
+     * Normally, no rendering takes place as long as tiles are still waiting to be sent, as
+     * rendering would change the frame buffer content in transit. With a back buffer, changed widgets are
+     * rendered into the back buffer meanwhile. As soon as all tiles of the front buffer are sent,
+     * both buffers swap their roles and the tiles rendered into the back buffer are sent.
+     * This shortens the latency of fast-changing content if the display is updated in many small steps.
+     *
+     * The back buffer must have the same size as the U8g2 frame buffer (e.g. 1024 bytes for a 128x64 display),
+     * it is not used otherwise. Note that U8g2 alternately renders into its own buffer and this one
+     * afterwards. Set the back buffer before the interface is initialized and do not change it later on.
+     *
+     * @param buffer Memory for the back buffer, nullptr to switch off double buffering
+     * @param size Size of the buffer in bytes
+     */
+    void setBackBuffer(uint8_t* buffer=nullptr,uint16_t size=0);
+
+    /** Enables or disables skipping of tiles whose content has not changed since they have been sent.
+     *
+     * Widgets often re-render content which looks exactly as before, e.g. a text line
+     * which gets the same temperature value in a new string. If tile checksums are enabled,
+     * UIDisplay computes a checksum of every tile before sending it and sends only those tiles
+     * whose checksum differs from the one of the last transmission.
+     *
+     * The checksums are stored in the given array which must have one entry per display tile,
+     * i.e. at least 128 entries for a 128x64 display. As always in UiUiUi, no heap space is used,
+     * so define the array statically in your sketch. Checksum computation needs some CPU time,
+     * but on slow serial connections this is almost always much less than sending the tiles.
+     *
+     * Tile checksums work only with a full frame buffer. Forced rendering always sends all tiles
+     * so that display and checksums are in sync again. Tiles are only skipped after such a forced
+     * rendering has been sent completely, so call render() with force=true after enabling.
+     * Note that - as with any checksum - there is a tiny chance that a changed tile has the same
+     * checksum as before. It will then not be sent until it changes again or a forced rendering takes place.
+     *
+     * @param checksums Array for storing the checksums, nullptr disables tile checksums (default)
+     * @param count Number of entries in the checksums array, if too small, tile checksums stay disabled
+     */
+    void setTileChecksums(uint16_t* checksums=nullptr,uint16_t count=0);
+
     /** Enable the UI: It presents itself on screen, display is turned on.
      *
      * @param display U8g2 display to work on
@@ -122,6 +293,12 @@ class UIDisplay: public UIParent {
     /** Called by the root widget to indicate that rendering must be performed. */
     void childNeedsRendering(UIWidget *child);
 
+    /** Called by the root widget to indicate that the layout must be updated. */
+    void childNeedsLayout(UIWidget *child);
+
+    /** Called by the root widget if some widget wants to be rendered after the given time. */
+    void childDefersRendering(UIWidget *child,UIArea *area,uint16_t millis);
+
     /** Render the interface, update everything that has changed since the last render() call.
      *
      * Rendering is performed by calling the render() method of every widget in the UI
@@ -139,8 +316,15 @@ class UIDisplay: public UIParent {
      * This method only makes sense if the number of updated tiles is limited and display
      * updates could be split into several calls of render(). Then, this method returns true
      * if such delayed updates are still vacant. If not, it returns false. This also means
-     * that calls to render() will return almost immediately. */
-    bool isUpdatingDisplay();
+     * that calls to render() will return almost immediately.
+     *
+     * If a non-blocking transfer is used, pass the display to take a running transfer into account. */
+    bool isUpdatingDisplay(U8G2* display=nullptr);
+
+#if UIUIUI_STATISTICS
+    /** Return the rendering and transfer statistics of this display, only available if UIUIUI_STATISTICS is set. */
+    UIDisplayStatistics* getStatistics() { return &statistics; }
+#endif
 
   private:
 
@@ -156,25 +340,188 @@ class UIDisplay: public UIParent {
     /** Flag if actual rendering must be performed. */
     bool renderingNeeded;
 
+    /** Flag if the layout must be updated before rendering. */
+    bool layoutNeeded;
+
     /** Maximum number of tiles which are updated in a display update cycle with actual rendering */
     uint16_t maxFirstUpdateTiles;
 
     /** Maximum number of tiles which are updated in a display update cycle without actual rendering */
     uint16_t maxFollowUpdateTiles;
 
+    /** Maximum time in microseconds for rendering and updating tiles in one cycle, 0 if unlimited */
+    uint32_t maxFirstUpdateMicros;
+
+    /** Maximum time in microseconds for updating tiles in a cycle without rendering, 0 if unlimited */
+    uint32_t maxFollowUpdateMicros;
+
+    /** Minimum time in milliseconds between two renderings, 0 if unlimited */
+    uint16_t minRenderMillis;
+
+    /** Time in milliseconds to collect changes before rendering, 0 if rendering starts immediately */
+    uint16_t coalesceMillis;
+
+    /** Start time of the last rendering */
+    uint32_t lastRenderMillis;
+
+    /** Time of the first change which has not yet been rendered */
+    uint32_t firstChangeMillis;
+
+    /** Flag whether some widget wants to be rendered at deferredMillis */
+    bool renderingDeferred;
+
+    /** Time at which the earliest deferred rendering is due */
+    uint32_t deferredMillis;
+
+    /** Collects the areas of deferring widgets during the dry run of renderPages(), nullptr otherwise */
+    UIAreaList* deferredAreas;
+
+    /** Measured time to send one tile in 1/16 microseconds, 0 if not measured yet */
+    uint32_t tileMicros16;
+
+    /** Non-blocking transfer of tiles to the display, nullptr if tiles are sent synchronously */
+    UITransfer* transfer;
+
+    /** Time at which the running transfer has been started */
+    uint32_t transferStartMicros;
+
+    /** Number of tiles in the running transfer, 0 if its time has been measured already */
+    uint16_t transferTileCount;
+
+    /** Flag whether a forced rendering was requested while a transfer was running */
+    bool forcePending;
+
+    /** Updates posted by interrupts or other tasks, nullptr if there are none */
+    UIUpdateQueue* updateQueue;
+
+    /** Task rendering this display, nullptr if render() is called by the sketch */
+    UIRenderWorker* renderWorker;
+
+    /** Function called when rendering becomes necessary, nullptr if none */
+    UIDisplayCallback renderingNeededCallback;
+
+    /** Function called when render() leaves tiles to be sent, nullptr if none */
+    UIDisplayCallback updatePendingCallback;
+
+    /** The buffer which is currently not sent to the display, nullptr if double buffering is off */
+    uint8_t* backBuffer;
+
+    /** Size of the back buffer in bytes */
+    uint16_t backBufferSize;
+
+    /** Flag whether the back buffer contains newer content than the front buffer. */
+    bool backBufferPending;
+
+    /** Dimensions IN TILES rendered into the back buffer, sent after the buffers have been swapped */
+    UIAreaList backUpdateTiles;
+
     /** Dimension IN TILES to actually update */
     UIArea updateTiles;
 
     /** Dimension IN TILES to update after the current update tiles have been finished */
     UIArea furtherUpdateTiles;
 
+    /** Dimensions IN TILES to update after updateTiles and furtherUpdateTiles have been finished */
+    UIAreaList pendingUpdateTiles;
+
+    /** Checksums of the tiles as they have been sent the last time, nullptr if tile checksums are disabled. */
+    uint16_t* tileChecksums;
+
+    /** Number of entries in the tileChecksums array */
+    uint16_t tileChecksumCount;
+
+    /** Flag whether the stored tile checksums reflect the display content. */
+    bool tileChecksumsValid;
+
+    /** Flag whether the tiles of a forced rendering are sent, checksums become valid afterwards. */
+    bool tileChecksumsSyncing;
+
+#if UIUIUI_STATISTICS
+    /** Rendering and transfer statistics of this display */
+    UIDisplayStatistics statistics;
+
+    /** Start time of the rendering whose tiles are currently sent to the display */
+    uint32_t updateStartMicros;
+
+    /** Flag whether the update latency of a rendering is currently measured */
+    bool updateLatencyMeasuring=false;
+#endif
+
     /** Update tiles on the display.
      *
-     * Tiles to be updated are stored in the updateTiles field.
+     * Tiles to be updated are stored in the updateTiles field,
+     * followed by furtherUpdateTiles and the areas in pendingUpdateTiles.
      *
      * @param maxUpdateTiles Maximum number of tiles to update at once (at least one row or column)
      */
     void doUpdateTiles(U8G2 *display,uint16_t maxUpdateTiles);
+
+    /** Actual rendering of render(), without calling the callbacks. */
+    void doRender(U8G2 *display,bool force);
+
+    /** Return whether changes are to be rendered now, takes deferred rendering and render interval into account. */
+    bool isRenderingDue();
+
+    /** Reset the need for rendering as the rendering starts now. */
+    void startRendering();
+
+    /** Call the rendering needed callback if it is set and the interface can be rendered. */
+    void signalRenderingNeeded();
+
+    /** Move the next area to update into updateTiles, clear updateTiles if there is none. */
+    void takeNextUpdateTiles();
+
+    /** Compute preferred sizes and layout again where widgets have signalled a layout change. */
+    void updateLayout(U8G2 *display);
+
+    /** Render in page buffer mode: Find changed areas, then render and send the affected pages one by one. */
+    void renderPages(U8G2 *display,bool force);
+
+    /** Add the tiles of deferred widgets which are on the pages of the dirty tiles to these.
+     *
+     * Rendering a page draws every widget on it with its current content, also one which defers its change.
+     * Such a widget is shown completely then, also on pages which would not have been rendered otherwise.
+     */
+    void addDeferredTiles(U8G2 *display,UIAreaList *dirtyTiles,UIAreaList *deferred);
+
+    /** Send the given tiles which must be within the current page of a page buffer. */
+    void sendPageTiles(U8G2 *display,UIArea *tiles);
+
+    /** Return whether a back buffer is set and large enough for the display's frame buffer. */
+    bool isBackBufferUsable(U8G2 *display);
+
+    /** Render the changed widgets into the back buffer, collect their tiles in backUpdateTiles. */
+    void renderBackBuffer(U8G2 *display);
+
+    /** Make the back buffer the front buffer and queue the tiles rendered into it for sending. */
+    void swapBuffers(U8G2 *display);
+
+    /** Return the number of tiles which can be sent within the given time, at most maxTiles. */
+    uint16_t tilesWithinTime(uint16_t maxTiles,uint32_t maxMicros);
+
+    /** Add a measurement of the time needed to send the given number of tiles to tileMicros16. */
+    void calibrateTileMicros(uint32_t micros,uint16_t tiles);
+
+    /** Return whether a transfer is running, measure the time per tile when it has ended. */
+    bool isTransferRunning(U8G2 *display);
+
+    /** Send the given area of tiles to the display, skip unchanged tiles if tile checksums are enabled. */
+    void sendDisplayArea(U8G2 *display,uint8_t left,uint8_t top,uint8_t width,uint8_t height);
+
+    /** Send the first run of changed tiles in the given part of a row, return the column after what is done. */
+    uint8_t sendChangedRun(U8G2 *display,uint8_t left,uint8_t y,uint8_t width);
+
+    /** Return whether tile checksums are set and cover the whole display. */
+    bool areTileChecksumsUsable(U8G2 *display);
+
+    /** Store the checksum of the given tile, return whether it has changed since it was sent last. */
+    bool updateTileChecksum(U8G2 *display,uint8_t x,uint8_t y);
+
+    /** Compute the checksum of the content of the tile at the given tile coordinates. */
+    uint16_t computeTileChecksum(U8G2 *display,uint8_t x,uint8_t y);
+
+    /** Actually transfer the given area of tiles to the display, account for it in the statistics and in tileMicros16. */
+    void transferTiles(U8G2 *display,uint8_t left,uint8_t top,uint8_t width,uint8_t height);
 	
 	
 	/** Calculates the tiles on the display that correspond to the pixels in the given area.
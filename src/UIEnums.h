@@ -11,4 +11,7 @@ enum UIAlignment { TopLeft,TopCenter,TopRight,CenterLeft,Center,CenterRight,Bott
 /** Expansion directions if there is more space on the display than preferred. */
 enum UIExpansion { None,Horizontal,Vertical,Both };
 
+/** Formats of bitmap data, see UIBitmap. */
+enum UIBitmapFormat : uint8_t { XBMP,RLETiles,Tiles };
+
 // end of file
@@ -10,6 +10,7 @@
 #include "UIPoint.h"
 #include "UISize.h"
 #include "UIArea.h"
+#include "UIAreaList.h"
 #include "UIWidget.h"
 #include "UIEnvelope.h"
 
@@ -35,7 +36,7 @@ void UIEnvelope::layout(U8G2 *display,UIArea *dim) {
       UIPoint topLeft=contentDim.alignedTopLeft(alignment,&preferredContentSize);
       contentDim.set(&topLeft,&preferredContentSize);
     }
-    content->layout(display,&contentDim);
+    layoutChild(display,content,&contentDim);
   }
 }
 
@@ -43,6 +44,18 @@ void UIEnvelope::childNeedsRendering(UIWidget *child) {
   signalNeedsRendering(); // just pass signal to parent
 }
 
+bool UIEnvelope::refreshChildrenSizes(U8G2* display) {
+  return (content?content->refreshPreferredSize(display):false);
+}
+
+void UIEnvelope::childNeedsLayout(UIWidget *child) {
+  signalNeedsLayout();
+}
+
+void UIEnvelope::childDefersRendering(UIWidget *child,UIArea *area,uint16_t millis) {
+  signalDefersRendering(area,millis);
+}
+
 UIArea* UIEnvelope::render(U8G2 *display,bool force) {
   if (force) {
     clearFull(display);
@@ -54,6 +67,17 @@ UIArea* UIEnvelope::render(U8G2 *display,bool force) {
     return (content?content->render(display,false):&UIArea::EMPTY);
 }
 
+void UIEnvelope::doRenderAreas(U8G2 *display,bool force,UIAreaList* rendered) {
+  if (force) {  // as render(), but the content is skipped if it is outside the current page of a page buffer
+    clearFull(display);
+    addRendered(rendered,&dim);
+    if (content)
+      content->renderAreas(display,true,rendered);
+  }
+  else if (content)
+    content->renderAreas(display,false,rendered);
+}
+
 void UIEnvelope::computePreferredSize(U8G2 *display,UISize *preferredSize) {
   if (content) {
     UISize contentSize=content->preferredSize(display);
@@ -10,6 +10,7 @@
 #include "UIPoint.h"
 #include "UISize.h"
 #include "UIArea.h"
+#include "UIAreaList.h"
 #include "UIWidget.h"
 #include "UIParent.h"
 
@@ -58,8 +59,20 @@ class UIEnvelope : public UIWidget, public UIParent {
     /** Called by the child of this envelope to indicate that it wants to be rendered. */
     void childNeedsRendering(UIWidget *child);
 
+    /** Called by the child of this envelope to indicate that its layout has changed. */
+    void childNeedsLayout(UIWidget *child);
+
+    /** Called by the child of this envelope which wants to be rendered after the given time. */
+    void childDefersRendering(UIWidget *child,UIArea *area,uint16_t millis);
+
   protected:
 
+    /** Refresh the preferred size of the content if its layout is pending. */
+    bool refreshChildrenSizes(U8G2* display);
+
+    /** Render the envelope, collecting the changed areas of the content separately. */
+    void doRenderAreas(U8G2 *display,bool force,UIAreaList* rendered);
+
     /** Compute the preferred size which is determined by the content by may be changed by the envelope. */
     void computePreferredSize(U8G2 *display,UISize *preferredSize);
 
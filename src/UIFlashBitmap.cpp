@@ -0,0 +1,34 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// (C) 2023 Dirk Hillbrecht
+
+#include "Arduino.h"
+#include <U8g2lib.h>
+
+#include "UIEnums.h"
+#include "UISize.h"
+#include "UIArea.h"
+#include "UIWidget.h"
+#include "UIBitmap.h"
+#include "UIFlashBitmap.h"
+
+UIFlashBitmap::UIFlashBitmap(const UIBitmapDescriptor *descriptor,UIWidget* next):
+  UIWidget(next),descriptor(descriptor) {}
+
+UIArea* UIFlashBitmap::render(U8G2* display,bool force) {
+  if (force && dim.hasArea()) {
+    UIBitmapDescriptor bitmap;
+    memcpy_P(&bitmap,descriptor,sizeof(UIBitmapDescriptor));
+    UISize imageSize=UISize(bitmap.width,bitmap.height);
+    clip(display);
+    UIBitmap::drawBitmap(display,&dim,&imageSize,bitmap.bitmap,bitmap.alignment,bitmap.format);
+    return &dim;
+  }
+  else
+    return &UIArea::EMPTY;
+}
+
+void UIFlashBitmap::computePreferredSize(U8G2 *display,UISize *preferredSize) {
+  preferredSize->set(pgm_read_word(&descriptor->width),pgm_read_word(&descriptor->height));
+}
+
+// end of file
@@ -0,0 +1,66 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// (C) 2023 Dirk Hillbrecht
+
+#pragma once
+
+#include "Arduino.h"
+#include <U8g2lib.h>
+
+#include "UIEnums.h"
+#include "UISize.h"
+#include "UIArea.h"
+#include "UIWidget.h"
+
+/** Immutable description of a bitmap, meant to be stored in flash memory.
+ *
+ *     const uint8_t logo_bits[] PROGMEM = { ... };
+ *     const UIBitmapDescriptor logo PROGMEM = { 32, 32, logo_bits, UIAlignment::Center };
+ */
+struct UIBitmapDescriptor {
+
+  /** Width of the bitmap */
+  uint16_t width;
+
+  /** Height of the bitmap */
+  uint16_t height;
+
+  /** The bitmap data, also in PROGMEM */
+  const uint8_t* bitmap;
+
+  /** Alignment of the bitmap in the widget's area */
+  UIAlignment alignment;
+
+  /** Format of the bitmap data, XBMP if omitted, see UIBitmap */
+  UIBitmapFormat format;
+
+};
+
+/** A widget showing a bitmap whose complete description is stored in flash memory.
+ *
+ * This widget does the same as UIBitmap, but it keeps only one pointer to a UIBitmapDescriptor
+ * in RAM instead of bitmap pointer, size and alignment. On microcontrollers with very little RAM,
+ * this saves some bytes per bitmap.
+ */
+class UIFlashBitmap : public UIWidget {
+
+  public:
+
+    /** Create a bitmap from the descriptor in PROGMEM and a potential successor. */
+    UIFlashBitmap(const UIBitmapDescriptor *descriptor,UIWidget* next=nullptr);
+
+    /** A bitmap is only rendered if the rendering is forced, otherwise it never changes. */
+    UIArea* render(U8G2* display,bool force);
+
+  protected:
+
+    /** Generate the preferred size from the bitmap size. */
+    void computePreferredSize(U8G2 *display,UISize *preferredSize);
+
+  private:
+
+    /** Descriptor of the bitmap, in PROGMEM. */
+    const UIBitmapDescriptor* descriptor;
+
+};
+
+// end of file
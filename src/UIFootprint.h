@@ -0,0 +1,42 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// (C) 2023 Dirk Hillbrecht
+
+#pragma once
+
+#include "Arduino.h"
+
+/** Compile-time computation of the RAM used by a set of UiUiUi objects.
+ *
+ * As all widgets of a UiUiUi interface are defined statically, the compiler knows how many
+ * bytes they occupy. UIFootprint::of() sums up the sizes of all passed objects at compile time,
+ * so a sketch can make the build fail if its interface grows beyond some budget:
+ *
+ *     static_assert(UIFootprint::of(textLine,rows,display)<=200,"Interface too large");
+ *
+ * or shorter with the UIUIUI_FOOTPRINT_BUDGET() macro:
+ *
+ *     UIUIUI_FOOTPRINT_BUDGET(200,textLine,rows,display);
+ *
+ * Note that the sizes differ between architectures: Pointers have 2 bytes on AVR
+ * and 4 bytes on ARM or Xtensa, alignment rules differ, too. A budget checks the footprint
+ * of the architecture the sketch is compiled for. Static memory used by the library itself
+ * (e.g. UITextWidthCache) is not included.
+ */
+class UIFootprint final {
+
+  public:
+
+    /** Return the number of bytes of no objects at all, i.e. 0. */
+    static constexpr size_t of() { return 0; }
+
+    /** Return the sum of the sizes of all passed objects. */
+    template<typename First,typename... Rest>
+    static constexpr size_t of(const First& first,const Rest&... rest) { return sizeof(First)+of(rest...); }
+
+};
+
+/** Fail compilation if the passed objects need more than the given number of bytes. */
+#define UIUIUI_FOOTPRINT_BUDGET(bytes,...) \
+  static_assert(UIFootprint::of(__VA_ARGS__)<=(bytes),"UiUiUi objects exceed footprint budget of " #bytes " bytes")
+
+// end of file
@@ -0,0 +1,194 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// (C) 2023 Dirk Hillbrecht
+
+#include "Arduino.h"
+#include <U8g2lib.h>
+
+#include "UIPoint.h"
+#include "UISize.h"
+#include "UIArea.h"
+#include "UIFrameBuffer.h"
+
+
+bool UIFrameBuffer::isAccessible(U8G2* display) {
+  u8g2_t *u8g2=display->getU8g2();
+  return u8g2->ll_hvline==u8g2_ll_hvline_vertical_top_lsb &&
+      (u8g2->cb==U8G2_R0 || u8g2->cb==U8G2_R1 || u8g2->cb==U8G2_R2 || u8g2->cb==U8G2_R3);
+}
+
+void UIFrameBuffer::clear(U8G2* display,UIArea* area) {
+  display->setDrawColor(0);
+  if (!fill(display,area,Clear))
+    display->drawBox(area->left,area->top,(area->right-area->left),(area->bottom-area->top));
+}
+
+/* Fill the area: Map it to buffer coordinates and write column byte by column byte. */
+bool UIFrameBuffer::fill(U8G2* display,UIArea* area,Pattern pattern) {
+  if (!isAccessible(display))
+    return false;
+  u8g2_t *u8g2=display->getU8g2();
+  // Restrict the area to the clip window and the current page, all in user coordinates
+  int x0=max(max((int)area->left,(int)u8g2->clip_x0),(int)u8g2->user_x0);
+  int y0=max(max((int)area->top,(int)u8g2->clip_y0),(int)u8g2->user_y0);
+  int x1=min(min((int)area->right,(int)u8g2->clip_x1),(int)u8g2->user_x1);
+  int y1=min(min((int)area->bottom,(int)u8g2->clip_y1),(int)u8g2->user_y1);
+  if (x0>=x1 || y0>=y1)
+    return true;
+  // Rotate into buffer coordinates, c0/r0 inclusive, c1/r1 exclusive, the area's top left pixel is at cornerC/cornerR
+  int width=display->getDisplayWidth(),height=display->getDisplayHeight();
+  int c0,r0,c1,r1,cornerC,cornerR;
+  if (u8g2->cb==U8G2_R0) {
+    c0=x0;c1=x1;r0=y0;r1=y1;
+  }
+  else if (u8g2->cb==U8G2_R1) {
+    c0=height-y1;c1=height-y0;r0=x0;r1=x1;
+  }
+  else if (u8g2->cb==U8G2_R2) {
+    c0=width-x1;c1=width-x0;r0=height-y1;r1=height-y0;
+  }
+  else {
+    c0=y0;c1=y1;r0=width-x1;r1=width-x0;
+  }
+  toBuffer(display,area->left,area->top,&cornerC,&cornerR);
+  // Checkerboard pixels are set where column+row has another parity than at the area's top left pixel
+  int cornerParity=(cornerC+cornerR)&1;
+  uint16_t stride=display->getBufferTileWidth()*8;
+  int firstRow=u8g2->tile_curr_row*8;
+  for (int row=r0&~7;row<r1;row+=8) {
+    uint8_t mask=0xff;
+    if (row<r0)
+      mask&=(0xff<<(r0-row));
+    if (row+8>r1)
+      mask&=(0xff>>(row+8-r1));
+    uint8_t *ptr=u8g2->tile_buf_ptr+(row-firstRow)/8*stride+c0;
+    if (mask==0xff && pattern!=Checkerboard) {  // Whole bytes of one value, the most common case for clearing
+      memset(ptr,(pattern==Solid?0xff:0x00),c1-c0);
+      continue;
+    }
+    for (int column=c0;column<c1;column++,ptr++) {
+      uint8_t bits=(pattern==Solid?0xff:pattern==Checkerboard?((column+cornerParity)&1?0x55:0xaa):0x00);
+      *ptr=(*ptr&~mask)|(bits&mask);
+    }
+  }
+  return true;
+}
+
+/* Same rotation as in fill(), for a single pixel. */
+void UIFrameBuffer::toBuffer(U8G2* display,int x,int y,int* c,int* r) {
+  u8g2_t *u8g2=display->getU8g2();
+  int width=display->getDisplayWidth(),height=display->getDisplayHeight();
+  if (u8g2->cb==U8G2_R0) {
+    *c=x;*r=y;
+  }
+  else if (u8g2->cb==U8G2_R1) {
+    *c=height-1-y;*r=x;
+  }
+  else if (u8g2->cb==U8G2_R2) {
+    *c=width-1-x;*r=height-1-y;
+  }
+  else {
+    *c=y;*r=width-1-x;
+  }
+}
+
+/* A byte at an arbitrary row spreads over two buffer bytes, the parts without set pixels are not touched at all. */
+void UIFrameBuffer::orBits(U8G2* display,int c,int r,uint8_t bits) {
+  u8g2_t *u8g2=display->getU8g2();
+  uint16_t stride=display->getBufferTileWidth()*8;
+  int tileRow=(r>=0?r/8:(r-7)/8)-u8g2->tile_curr_row;
+  uint8_t off=r&7;
+  uint8_t upper=bits<<off;
+  uint8_t lower=(off?bits>>(8-off):0);
+  if (upper)
+    u8g2->tile_buf_ptr[tileRow*stride+c]|=upper;
+  if (lower)
+    u8g2->tile_buf_ptr[(tileRow+1)*stride+c]|=lower;
+}
+
+UIFrameBuffer::TileWriter::TileWriter(U8G2* display,UIPoint* topLeft,UISize* size):
+  display(display),topLeft(topLeft->x,topLeft->y),size(size),column(0),tileRow(0) {
+  u8g2_t *u8g2=display->getU8g2();
+  direct=isAccessible(display);
+  copyRows=(direct && u8g2->cb==U8G2_R0 && (topLeft->y&7)==0);
+  window.set(max(u8g2->clip_x0,u8g2->user_x0),max(u8g2->clip_y0,u8g2->user_y0),
+      min(u8g2->clip_x1,u8g2->user_x1),min(u8g2->clip_y1,u8g2->user_y1));
+}
+
+void UIFrameBuffer::TileWriter::put(uint8_t bits) {
+  int rows=size.height-tileRow*8;  // Pixels below the bitmap are ignored
+  if (rows<8)
+    bits&=(0xff>>(8-rows));
+  int x=topLeft.x+column;
+  int y=topLeft.y+tileRow*8;
+  if (direct) {
+    int first=max((int)window.top-y,0);
+    int last=min((int)window.bottom-y,8);
+    if (x>=window.left && x<window.right && first<last)
+      bits&=(0xff<<first)&(0xff>>(8-last));
+    else
+      bits=0;
+    if (bits) {
+      u8g2_t *u8g2=display->getU8g2();
+      int c,r;
+      toBuffer(display,x,y,&c,&r);
+      if (u8g2->cb==U8G2_R0)
+        orBits(display,c,r,bits);
+      else if (u8g2->cb==U8G2_R2) {  // upside down: the byte ends at r, its bits in reverse order
+        uint8_t reversed=0;
+        for (uint8_t i=0;i<8;i++,bits>>=1)
+          reversed=(reversed<<1)|(bits&1);
+        orBits(display,c,r-7,reversed);
+      }
+      else {  // the byte lies across the buffer columns, one bit each
+        int step=(u8g2->cb==U8G2_R1?-1:1);
+        for (;bits;bits>>=1,c+=step)
+          if (bits&1)
+            orBits(display,c,r,1);
+      }
+    }
+  }
+  else {
+    for (uint8_t i=0;bits;i++,bits>>=1)
+      if (bits&1)
+        display->drawPixel(x,y+i);
+  }
+  skip(1);
+}
+
+void UIFrameBuffer::TileWriter::putRow(const uint8_t* bits) {
+  int y=topLeft.y+tileRow*8;
+  if (copyRows && size.height-tileRow*8>=8 && y>=window.top && y+8<=window.bottom) {
+    // Full tile row within the window: Copy the visible columns at once
+    int first=max((int)window.left-(int)topLeft.x,0);
+    int last=min((int)window.right-(int)topLeft.x,(int)size.width);
+    if (first<last) {
+      u8g2_t *u8g2=display->getU8g2();
+      memcpy_P(u8g2->tile_buf_ptr+(y/8-u8g2->tile_curr_row)*display->getBufferTileWidth()*8+topLeft.x+first,bits+first,last-first);
+    }
+    skip(size.width);
+  }
+  else if (direct && (y>=window.bottom || y+8<=window.top))  // Row not visible, e.g. on another page
+    skip(size.width);
+  else {
+    for (UICoordinate i=0;i<size.width;i++)
+      put(pgm_read_byte(bits+i));
+  }
+}
+
+void UIFrameBuffer::TileWriter::skip(uint16_t count) {
+  while (count>0 && !isFinished()) {
+    uint16_t step=min(count,(uint16_t)(size.width-column));
+    column+=step;
+    count-=step;
+    if (column>=size.width) {
+      column=0;
+      tileRow++;
+    }
+  }
+}
+
+bool UIFrameBuffer::TileWriter::isFinished() {
+  return tileRow*8>=size.height;
+}
+
+// end of file
@@ -0,0 +1,131 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// (C) 2023 Dirk Hillbrecht
+
+#pragma once
+
+#include "Arduino.h"
+#include <U8g2lib.h>
+
+#include "UIPoint.h"
+#include "UISize.h"
+#include "UIArea.h"
+
+/** Direct access to the frame buffer of U8g2 for filling areas with simple patterns.
+ *
+ * U8g2 draws boxes and bitmaps pixel by pixel, each pixel passes clipping, rotation and
+ * draw color handling. For large areas with a simple pattern, this is very slow.
+ * UIFrameBuffer writes the pattern bytes directly into the frame buffer instead:
+ * Rows of bytes completely inside the area are set with memset(), bytes at the top and
+ * bottom edge of the area are masked.
+ *
+ * This works for all displays whose frame buffer is organised in vertical bytes
+ * (like SSD1306, SH1106 and most other monochrome OLED controllers), for all four rotations
+ * U8G2_R0 to U8G2_R3, in full buffer and in page buffer mode. The current clip window is respected.
+ * For all other displays, fill() returns false and the caller has to draw with U8g2 as usual.
+ *
+ * All members are static, there are no instances of this class.
+ */
+class UIFrameBuffer final {
+
+  public:
+
+    /** Patterns an area can be filled with. */
+    enum Pattern {
+      Clear,        ///< All pixels cleared
+      Solid,        ///< All pixels set
+      Checkerboard  ///< Pixels set and cleared alternately, top left pixel of the area cleared
+    };
+
+    /** Fill the area of the display with the pattern.
+     *
+     * @param display The display to draw into
+     * @param area The area to fill, in display coordinates
+     * @param pattern The pattern to fill the area with
+     * @return true if the area has been filled, false if the frame buffer cannot be accessed directly
+     */
+    static bool fill(U8G2* display,UIArea* area,Pattern pattern);
+
+    /** Clear the area of the display, directly in the frame buffer if possible, with U8g2's drawBox() otherwise.
+     *
+     * Leaves the draw color of the display at 0 in both cases.
+     */
+    static void clear(U8G2* display,UIArea* area);
+
+    /** Return whether the frame buffer of the display can be accessed directly. */
+    static bool isAccessible(U8G2* display);
+
+  private:
+
+    /** Map the pixel at the given display coordinates to its column and pixel row in the frame buffer. */
+    static void toBuffer(U8G2* display,int x,int y,int* c,int* r);
+
+    /** Set the pixels of a vertical byte in the frame buffer at column c with bit 0 at pixel row r, which may be unaligned. */
+    static void orBits(U8G2* display,int c,int r,uint8_t bits);
+
+  public:
+
+    /** Sequential writer of a bitmap in U8g2's tile layout.
+     *
+     * The bitmap is passed tile row by tile row, each tile row column by column.
+     * Each byte contains 8 pixels on top of each other, the least significant bit on top.
+     * Only set pixels are drawn, the background must have been cleared before.
+     *
+     * If the frame buffer is accessible, the bytes are written directly into the buffer in all four
+     * rotations, split across two buffer bytes if the bitmap does not start at the top of a tile row.
+     * putRow() copies whole rows if the display is not rotated and the bitmap starts at the top of a tile row.
+     * Otherwise, the set pixels are drawn one by one with U8g2. Clipping is respected in all cases.
+     */
+    class TileWriter final {
+
+      public:
+
+        /** Prepare writing a bitmap of the given size at the given position. */
+        TileWriter(U8G2* display,UIPoint* topLeft,UISize* size);
+
+        /** Draw the next byte of the bitmap. */
+        void put(uint8_t bits);
+
+        /** Draw a complete tile row of the bitmap from PROGMEM, must be called at the begin of a tile row.
+         *
+         * If the bytes are written directly into the frame buffer, all bytes of the row
+         * which are completely visible are copied with one memcpy_P().
+         */
+        void putRow(const uint8_t* bits);
+
+        /** Skip the given number of bytes, they are left empty. */
+        void skip(uint16_t count);
+
+        /** Return whether all bytes of the bitmap have been written or skipped. */
+        bool isFinished();
+
+      private:
+
+        /** The display to draw to */
+        U8G2* display;
+
+        /** Position of the bitmap on the display */
+        UIPoint topLeft;
+
+        /** Size of the bitmap */
+        UISize size;
+
+        /** Column of the next byte within the bitmap */
+        UICoordinate column;
+
+        /** Tile row of the next byte within the bitmap */
+        UICoordinate tileRow;
+
+        /** Flag whether bytes are written directly into the frame buffer */
+        bool direct;
+
+        /** Flag whether whole tile rows can be copied into the frame buffer */
+        bool copyRows;
+
+        /** Intersection of clip window and current page, only used if writing directly */
+        UIArea window;
+
+    };
+
+};
+
+// end of file
@@ -0,0 +1,58 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// (C) 2023 Dirk Hillbrecht
+
+#include "Arduino.h"
+#include <U8g2lib.h>
+
+#include "UIConfig.h"
+#include "UIFreeRTOSRenderWorker.h"
+
+#if UIUIUI_FREERTOS
+
+UIFreeRTOSRenderWorker::UIFreeRTOSRenderWorker(StackType_t* stack,uint32_t stackDepth,UBaseType_t priority,int8_t core):
+  UIRenderWorker(), stack(stack), stackDepth(stackDepth), priority(priority), core(core), task(nullptr) {}
+
+void UIFreeRTOSRenderWorker::start(UIDisplay* display,U8G2* u8g2) {
+  this->display=display;
+  this->u8g2=u8g2;
+#if defined(ESP_PLATFORM)
+  task=xTaskCreateStaticPinnedToCore(taskFunction,"UiUiUi",stackDepth,this,priority,stack,&taskBuffer,
+      (core<0?tskNO_AFFINITY:core));
+#else
+  task=xTaskCreateStatic(taskFunction,"UiUiUi",stackDepth,this,priority,stack,&taskBuffer);
+#endif
+  wake();  // render whatever has been changed before the start
+}
+
+void UIFreeRTOSRenderWorker::wake() {
+  if (!task)
+    return;
+#if defined(ESP_PLATFORM)
+  if (xPortInIsrContext()) {
+    BaseType_t higherPriorityTaskWoken=pdFALSE;
+    vTaskNotifyGiveFromISR(task,&higherPriorityTaskWoken);
+    if (higherPriorityTaskWoken)
+      portYIELD_FROM_ISR();
+    return;
+  }
+#endif
+  xTaskNotifyGive(task);
+}
+
+bool UIFreeRTOSRenderWorker::waitForWake() {
+  ulTaskNotifyTake(pdTRUE,portMAX_DELAY);
+  return true;
+}
+
+void UIFreeRTOSRenderWorker::pause(uint32_t millis) {
+  TickType_t ticks=pdMS_TO_TICKS(millis);
+  vTaskDelay(ticks>0?ticks:1);
+}
+
+void UIFreeRTOSRenderWorker::taskFunction(void* worker) {
+  ((UIFreeRTOSRenderWorker*)worker)->run();
+}
+
+#endif
+
+// end of file
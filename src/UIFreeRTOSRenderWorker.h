@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// (C) 2023 Dirk Hillbrecht
+
+#pragma once
+
+#include "Arduino.h"
+#include <U8g2lib.h>
+
+#include "UIConfig.h"
+#include "UIRenderWorker.h"
+
+#if UIUIUI_FREERTOS
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+/** Render worker running as FreeRTOS task.
+ *
+ * The task is created statically on start() with the stack given in the constructor, so - as everything
+ * in UiUiUi - it does not need any heap space. Define the stack as static array in the sketch:
+ *
+ *     StackType_t renderStack[4096];
+ *     UIFreeRTOSRenderWorker renderWorker(renderStack,4096,1,1);
+ *
+ * The task sleeps on a task notification which is given by wake(). wake() can also be called from
+ * an interrupt handler on the ESP32, so updates may be posted into an UIUpdateQueue from there.
+ *
+ * Only available if UIUIUI_FREERTOS is set, see UIConfig.h. FreeRTOS must support static allocation.
+ */
+class UIFreeRTOSRenderWorker: public UIRenderWorker {
+
+  public:
+
+    /** Create a FreeRTOS render worker.
+     *
+     * @param stack Memory for the stack of the task
+     * @param stackDepth Size of the stack in StackType_t units (bytes on the ESP32)
+     * @param priority Priority of the task
+     * @param core Core to pin the task to, -1 for no pinning. Pinning is only available on the ESP32.
+     */
+    UIFreeRTOSRenderWorker(StackType_t* stack,uint32_t stackDepth,UBaseType_t priority=1,int8_t core=-1);
+
+    /** Create and start the task rendering the given display. */
+    void start(UIDisplay* display,U8G2* u8g2);
+
+    /** Notify the task so that it renders the display, works also from interrupts on the ESP32. */
+    void wake();
+
+  protected:
+
+    /** Wait for the task notification. */
+    bool waitForWake();
+
+    /** Delay for the given time, at least one tick. */
+    void pause(uint32_t millis);
+
+  private:
+
+    /** Memory for the stack of the task */
+    StackType_t* stack;
+
+    /** Size of the stack */
+    uint32_t stackDepth;
+
+    /** Priority of the task */
+    UBaseType_t priority;
+
+    /** Core the task is pinned to, -1 for none */
+    int8_t core;
+
+    /** Task control block of the statically allocated task */
+    StaticTask_t taskBuffer;
+
+    /** Handle of the running task, nullptr before start() */
+    TaskHandle_t task;
+
+    /** Entry function of the task, parameter is the worker. */
+    static void taskFunction(void* worker);
+
+};
+
+#endif
+
+// end of file
@@ -13,7 +13,7 @@
 
 /* Create a horizontal line with an empty border on top and bottom (defaults to 0),
  * a line width (defaults to 1) and an optional successor. */
-UIHorizontalLine::UIHorizontalLine(uint16_t border,uint16_t lineWidth,UIWidget* next):
+UIHorizontalLine::UIHorizontalLine(UICoordinate border,UICoordinate lineWidth,UIWidget* next):
   UIWidget(next),border(border) {}
 
 /* Create a horizontal line of width 1 with no border on top and bottom. */
@@ -25,7 +25,7 @@ UIArea* UIHorizontalLine::render(U8G2 *display,bool force) {
     clip(display);
     clearFull(display);
     display->setDrawColor(1);
-    uint16_t y=(dim.top+dim.bottom)/2; // cannot overflow due to MAX_LEN
+    UICoordinate y=(dim.top+dim.bottom)/2; // computed in int, cannot overflow
     display->drawLine(dim.left,y,dim.right,y);
     return &dim;
   }
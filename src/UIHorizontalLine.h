@@ -19,7 +19,7 @@ class UIHorizontalLine : public UIWidget {
      *
      * Defaults to an empty border on top and bottom (default 0),
      * a tiny line width (defaults to 1) and an optional successor. */
-    UIHorizontalLine(uint16_t border=0,uint16_t lineWidth=1,UIWidget* next=nullptr);
+    UIHorizontalLine(UICoordinate border=0,UICoordinate lineWidth=1,UIWidget* next=nullptr);
 
     /** Create a horizontal line of width 1 with no border on top and bottom. */
     UIHorizontalLine(UIWidget* next);
@@ -35,10 +35,7 @@ class UIHorizontalLine : public UIWidget {
   private:
 
     /** Width of the border. */
-    uint16_t border;
-
-    /** Width of the line. */
-    uint16_t lineWidth;
+    UICoordinate border;
 
 };
 
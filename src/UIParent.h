@@ -7,7 +7,7 @@
 
 /** Simple abstraction of elements which have at least one child.
  *
- * This pure virtual class is mainly implemented by UIWidgetGroup,
+ * This class is mainly implemented by UIWidgetGroup,
  * as that is the class which contains other widgets as children.
  * But as UIDisplay also has a child, it is implemented there, too.
  */
@@ -18,6 +18,22 @@ class UIParent {
     /** Called by any child of this group to indicate that it wants to be rendered. */
     virtual void childNeedsRendering(UIWidget *child)=0;
 
+    /** Called by any child of this group to indicate that its preferred size or its inner layout has changed.
+     *
+     * The default implementation ignores the change, the child keeps its area then.
+     */
+    virtual void childNeedsLayout(UIWidget *child) {}
+
+    /** Called by any child of this group which holds back a change, it wants to be rendered after the given time.
+     *
+     * The area is the one of the widget which actually holds back the change, it is passed up unchanged.
+     * The default implementation asks for rendering immediately, the child will defer again until its time has come.
+     * As UIWidgetGroup passes every such request on, the display renders about every millisecond until then
+     * (see UIDisplay::getRenderDelay()). Parents should rather pass the call on with signalDefersRendering()
+     * as UIWidgetGroup and UIEnvelope do.
+     */
+    virtual void childDefersRendering(UIWidget *child,UIArea *area,uint16_t millis) { childNeedsRendering(child); }
+
 };
 
 // end of file
@@ -5,7 +5,7 @@
 #include "UIPoint.h"
 
 /* Initialize the point from two values. */
-UIPoint::UIPoint(uint16_t x,uint16_t y): x(x),y(y) {}
+UIPoint::UIPoint(UICoordinate x,UICoordinate y): x(x),y(y) {}
 
 /* Initialize the point as "0,0" */
 UIPoint::UIPoint(): UIPoint(0,0) {}
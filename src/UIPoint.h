@@ -4,13 +4,14 @@
 #pragma once
 
 #include "Arduino.h"
+#include "UIConfig.h"
 
 /** Representation of a point on the display. */
 class UIPoint final {
   public:
 
     /** Initialize the point from two values. */
-    UIPoint(uint16_t x,uint16_t y);
+    UIPoint(UICoordinate x,UICoordinate y);
 
     /** Initialize the point as "0,0" */
     UIPoint();
@@ -22,10 +23,10 @@ class UIPoint final {
     void debugPrint(const char* label);
 
     /** X Coordinate of the point, normally 0 is top */
-    uint16_t x;
+    UICoordinate x;
 
     /** Y Coordinate of the point, normally 0 is left */
-    uint16_t y;
+    UICoordinate y;
 
 };
 
@@ -0,0 +1,28 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// (C) 2023 Dirk Hillbrecht
+
+#include "Arduino.h"
+#include <U8g2lib.h>
+
+#include "UIDisplay.h"
+#include "UIRenderWorker.h"
+
+UIRenderWorker::UIRenderWorker(): display(nullptr), u8g2(nullptr) {}
+
+void UIRenderWorker::run() {
+  while (waitForWake()) {
+    display->render(u8g2);
+    // Restricted tile updates, transfers and back buffers need further calls until everything is sent,
+    // changes held back by render intervals need a call when they are due.
+    // Changes during this time leave a wake-up, so the next wait returns immediately.
+    for (;;) {
+      uint32_t delay=(display->isUpdatingDisplay(u8g2)?1:display->getRenderDelay());
+      if (delay==0)
+        break;
+      pause(delay);
+      display->render(u8g2);
+    }
+  }
+}
+
+// end of file
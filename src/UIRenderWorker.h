@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// (C) 2023 Dirk Hillbrecht
+
+#pragma once
+
+#include "Arduino.h"
+#include <U8g2lib.h>
+
+class UIDisplay;
+
+/** Abstraction of a dedicated task which renders the interface and sends the tiles to the display.
+ *
+ * Normally, the sketch calls UIDisplay::render() regularly, e.g. from loop() or from a
+ * fixed-rate task. This polls: Most calls find nothing to do, and a change waits for the next call.
+ *
+ * A render worker runs render() on a task of its own instead. The task sleeps until it is woken
+ * and then renders and sends tiles until the display is up to date. UIDisplay wakes the worker
+ * whenever a widget signals a change (UIDisplay::childNeedsRendering()), and an UIUpdateQueue
+ * set at the display wakes it when an update is posted. On dual-core CPUs, the worker can be
+ * pinned to the core which does not run the networking stack.
+ *
+ * Once the worker runs, all widgets belong to it: Other tasks and interrupts must not call
+ * widget methods anymore, but post their changes into the display's UIUpdateQueue.
+ * The worker applies them at the beginning of each render() call.
+ *
+ * This pure virtual class contains the rendering loop. Implementations provide the task and the
+ * wake-up signal: UIFreeRTOSRenderWorker for FreeRTOS (e.g. ESP32) and UIThreadRenderWorker
+ * based on std::thread, e.g. for testing on the host.
+ */
+class UIRenderWorker {
+
+  public:
+
+    /** Create a render worker, it does not run before start() has been called. */
+    UIRenderWorker();
+
+    /** Start the task which renders the given display, called by UIDisplay::startRenderWorker(). */
+    virtual void start(UIDisplay* display,U8G2* u8g2)=0;
+
+    /** Wake the task so that it renders the display, may be called from any task. */
+    virtual void wake()=0;
+
+  protected:
+
+    /** The display rendered by this worker */
+    UIDisplay* display;
+
+    /** The U8g2 display to render on */
+    U8G2* u8g2;
+
+    /** Rendering loop of the task: Wait, render until all tiles and held back changes are sent, wait again. Returns after stopping. */
+    void run();
+
+    /** Wait until wake() is called or has been called since the last wait, return false if the task must stop. */
+    virtual bool waitForWake()=0;
+
+    /** Pause for the given time before render() is called again, must not consume a wake-up. */
+    virtual void pause(uint32_t millis)=0;
+
+};
+
+// end of file
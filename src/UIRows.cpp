@@ -25,23 +25,31 @@ void UIRows::layout(U8G2* display,UIArea* dim) {
   while (widget && stamp.bottom<dim->bottom) { // Walk through the widgets
     int requestedHeight=widget->preferredSize(display).height;
     // Bottom is top plus height of the current widget
-    stamp.bottom=min(dim->bottom,(uint16_t)(stamp.bottom+(requestedHeight==UISize::MAX_LEN?extendingHeight:requestedHeight)));
-    widget->layout(display,&stamp);
+    stamp.bottom=min((int)dim->bottom,stamp.bottom+(requestedHeight==UISize::MAX_LEN?extendingHeight:requestedHeight));
+    layoutChild(display,widget,&stamp);
     widget=widget->next;
     // For next widget, top will be current bottom
     stamp.top=stamp.bottom;
   }
+  // Widgets which do not fit anymore get an empty area
+  stamp.top=stamp.bottom;
+  while (widget) {
+    layoutChild(display,widget,&stamp);
+    widget=widget->next;
+  }
 }
 
 /* Preferred size of a rows group is computed by stacking the sub-widgets appripriately. */
 void UIRows::computePreferredSize(U8G2 *display,UISize *preferredSize) {
+  extendingChildrenCount=0;
+  fixedHeight=0;
   UIWidget* elem=firstChild;
   while (elem) {
     UISize otherDim=elem->preferredSize(display);
     if (otherDim.height==UISize::MAX_LEN)
       extendingChildrenCount+=1;
     else
-      fixedHeight+=otherDim.height;
+      fixedHeight=UISize::max_len_or(fixedHeight+otherDim.height);
     preferredSize->maxWidthCumulateHeight(&otherDim);
     elem=elem->next;
   }
@@ -46,7 +46,7 @@ class UIRows: public UIWidgetGroup {
     uint8_t extendingChildrenCount;
 
     /** Sum of all fixed height preferences (not "as high as possible") of the sub-widgets. */
-    uint16_t fixedHeight;
+    UICoordinate fixedHeight;
 
 };
 
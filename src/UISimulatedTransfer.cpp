@@ -0,0 +1,34 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// (C) 2023 Dirk Hillbrecht
+
+#include "Arduino.h"
+#include <U8g2lib.h>
+
+#include "UISimulatedTransfer.h"
+
+UISimulatedTransfer::UISimulatedTransfer(uint16_t microsPerTile):
+  microsPerTile(microsPerTile), tiles(), buffer(nullptr), startMicros(0), durationMicros(0) {}
+
+void UISimulatedTransfer::startTransfer(U8G2* display,uint8_t* buffer,UIArea* tiles) {
+  this->tiles.set(tiles);
+  this->buffer=buffer;
+  durationMicros=(uint32_t)microsPerTile*(tiles->right-tiles->left)*(tiles->bottom-tiles->top);
+  startMicros=micros();
+}
+
+bool UISimulatedTransfer::isTransferring(U8G2* display) {
+  if (!tiles.hasArea())
+    return false;
+  if (micros()-startMicros<durationMicros)
+    return true;
+  // Time is over: Send the tiles from the buffer they have been handed over in
+  u8g2_t *u8g2=display->getU8g2();
+  uint8_t *displayBuffer=u8g2->tile_buf_ptr;
+  u8g2->tile_buf_ptr=buffer;
+  display->updateDisplayArea(tiles.left,tiles.top,tiles.right-tiles.left,tiles.bottom-tiles.top);
+  u8g2->tile_buf_ptr=displayBuffer;
+  tiles.clear();
+  return false;
+}
+
+// end of file
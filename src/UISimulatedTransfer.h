@@ -0,0 +1,54 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// (C) 2023 Dirk Hillbrecht
+
+#pragma once
+
+#include "Arduino.h"
+#include <U8g2lib.h>
+
+#include "UIArea.h"
+#include "UITransfer.h"
+
+/** Tile transfer which simulates the latency of a non-blocking transfer.
+ *
+ * A started transfer is "running" for a fixed time per tile. Only when isTransferring()
+ * is called after that time, the tiles are actually sent to the display in one go via
+ * U8G2::updateDisplayArea().
+ *
+ * This class allows to test and benchmark the asynchronous transfer pipeline of UIDisplay
+ * on any hardware, even without display (see the RenderBenchmark example), and it serves as a template
+ * for actual implementations based on DMA, interrupts or background tasks.
+ */
+class UISimulatedTransfer: public UITransfer {
+
+  public:
+
+    /** Create a simulated transfer needing the given time per tile. */
+    UISimulatedTransfer(uint16_t microsPerTile);
+
+    /** Start the transfer, it finishes after microsPerTile times the number of tiles. */
+    void startTransfer(U8G2* display,uint8_t* buffer,UIArea* tiles);
+
+    /** Return whether the transfer is still running, send the tiles if its time has passed. */
+    bool isTransferring(U8G2* display);
+
+  private:
+
+    /** Simulated transfer time per tile */
+    uint16_t microsPerTile;
+
+    /** The tiles currently transferred, empty if no transfer is running */
+    UIArea tiles;
+
+    /** The buffer to send the tiles from */
+    uint8_t* buffer;
+
+    /** Start time of the current transfer */
+    uint32_t startMicros;
+
+    /** Duration of the current transfer */
+    uint32_t durationMicros;
+
+};
+
+// end of file
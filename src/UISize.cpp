@@ -6,19 +6,19 @@
 
 /** Representation of a size, i.e. a width and a height. */
 
-const uint16_t UISize::MAX_LEN=32767;  // Half of max value so that addition of two does not overflow
+const UICoordinate UISize::MAX_LEN;  // Value is given in the header so that it can be used at compile time
 
 const UISize MAX_SIZE=UISize(UISize::MAX_LEN,UISize::MAX_LEN);
 
 const UISize EMPTY=UISize();
 
-UISize::UISize(uint16_t width,uint16_t height): width(width), height(height) {}
+UISize::UISize(UICoordinate width,UICoordinate height): width(width), height(height) {}
 
 UISize::UISize(UISize *other): UISize(other->width,other->height) {}
 
 UISize::UISize(): UISize(0,0) {}
 
-void UISize::set(uint16_t width,uint16_t height) { this->width=width; this->height=height; }
+void UISize::set(UICoordinate width,UICoordinate height) { this->width=width; this->height=height; }
 
 void UISize::set(UISize *other) { set(other->width,other->height); }
 
@@ -53,19 +53,19 @@ bool UISize::isEmpty() {
   return width==0 && height==0;
 }
 
-/* Static helper method: maximum of two given uint16_t fields */
-uint16_t UISize::my_max(uint16_t a,uint16_t b) {
+/* Static helper method: maximum of two given coordinates */
+UICoordinate UISize::my_max(UICoordinate a,UICoordinate b) {
   return (a>b?a:b);
 }
 
-/* Static helper method: maximum of two given uint16_t fields */
-uint16_t UISize::my_min(uint16_t a,uint16_t b) {
+/* Static helper method: minimum of two given coordinates */
+UICoordinate UISize::my_min(UICoordinate a,UICoordinate b) {
   return (a<b?a:b);
 }
 
-/* Static helper method: restrict given value to MAX_LEN at most. */
-uint16_t UISize::max_len_or(uint16_t a) {
-  return my_min(MAX_LEN,a);
+/* Static helper method: restrict given value, e.g. a sum of two coordinates, to MAX_LEN at most. */
+UICoordinate UISize::max_len_or(uint16_t a) {
+  return (a>MAX_LEN?MAX_LEN:a);
 }
 
 void UISize::debugPrint(const char* label) {
@@ -4,12 +4,17 @@
 #pragma once
 
 #include "Arduino.h"
+#include "UIConfig.h"
 
 /** Representation of a size, i.e. a width and a height. */
 class UISize final {
   public:
-    /** Less than half of max value so that addition of two does not overflow */
-    static const uint16_t MAX_LEN;
+    /** Maximum length, also used as "as large as possible".
+     *
+     * With 16 bit coordinates, it is less than half of max value so that addition of two does not overflow.
+     * With 8 bit coordinates, it is the max value itself, sums are limited to it by max_len_or().
+     */
+    static const UICoordinate MAX_LEN=(UIUIUI_COMPACT_COORDINATES?255:32767);
 
     /** UISize representing maximal size in all directions */
     static const UISize MAX_SIZE;
@@ -18,7 +23,7 @@ class UISize final {
     static const UISize EMPTY;
 
     /** Initialize a size from a width and a height. */
-    UISize(uint16_t width,uint16_t height);
+    UISize(UICoordinate width,UICoordinate height);
 
     /** Initialize a size from another size */
     UISize(UISize *other);
@@ -27,13 +32,13 @@ class UISize final {
     UISize();
 
     /** Width */
-    uint16_t width;
+    UICoordinate width;
 
     /** Height */
-    uint16_t height;
+    UICoordinate height;
 
     /** Set height from a numeric width and height. */
-    void set(uint16_t width,uint16_t height);
+    void set(UICoordinate width,UICoordinate height);
 
     /** Set size from another referenced height */
     void set(UISize *other);
@@ -58,14 +63,14 @@ class UISize final {
     /** Return true if this size is empty, i.e. it has neither width nor height, i.e. both are 0. */
     bool isEmpty();
 
-    /** Static helper method: maximum of two given uint16_t fields */
-    static uint16_t my_max(uint16_t a,uint16_t b);
+    /** Static helper method: maximum of two given coordinates */
+    static UICoordinate my_max(UICoordinate a,UICoordinate b);
 
-    /** Static helper method: maximum of two given uint16_t fields */
-    static uint16_t my_min(uint16_t a,uint16_t b);
+    /** Static helper method: minimum of two given coordinates */
+    static UICoordinate my_min(UICoordinate a,UICoordinate b);
 
-    /** Static helper method: restrict given value to MAX_LEN at most. */
-    static uint16_t max_len_or(uint16_t a);
+    /** Static helper method: restrict given value, e.g. a sum of two coordinates, to MAX_LEN at most. */
+    static UICoordinate max_len_or(uint16_t a);
 
     /** Debug output of this size with some prepended label. */
     void debugPrint(const char* label);
@@ -0,0 +1,99 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// (C) 2023 Dirk Hillbrecht
+
+#include "Arduino.h"
+#include <U8g2lib.h>
+
+#include "UIEnums.h"
+#include "UIPoint.h"
+#include "UISize.h"
+#include "UIArea.h"
+#include "UIWidget.h"
+#include "UIBitmap.h"
+#include "UISprite.h"
+
+
+UISprite::UISprite(UICoordinate width,UICoordinate height,const uint8_t *atlas,uint8_t frameCount,UIBitmapFormat format,UIAlignment alignment,UIWidget* next):
+  UIBitmap(width,height,atlas,format,alignment,next),frame(0),
+  frameCount(format==UIBitmapFormat::RLETiles?1:frameCount),  // frames cannot be found in RLE data
+  renderedBitmap(nullptr) {}
+
+UISprite::UISprite(UICoordinate width,UICoordinate height,const uint8_t *atlas,uint8_t frameCount,UIWidget* next):
+  UISprite(width,height,atlas,frameCount,UIBitmapFormat::XBMP,UIAlignment::Center,next) {}
+
+/* The bitmap pointer of UIBitmap always points to the current frame */
+void UISprite::setFrame(uint8_t index) {
+  if (index<frameCount && index!=frame) {
+    bitmap+=((int)index-(int)frame)*(int)frameBytes();
+    frame=index;
+    signalNeedsRendering();
+  }
+}
+
+uint8_t UISprite::getFrame() {
+  return frame;
+}
+
+UIArea* UISprite::render(U8G2* display,bool force) {
+  if (force) {
+    renderedBitmap=bitmap;
+    return UIBitmap::render(display,true);
+  }
+  if (bitmap==renderedBitmap || !dim.hasArea())
+    return &UIArea::EMPTY;
+  UISize size=dim.getSize();
+  if (size.width<imageSize.width || size.height<imageSize.height) {  // The crossed box does not change
+    renderedBitmap=bitmap;
+    return &UIArea::EMPTY;
+  }
+  computeChangedArea();
+  renderedBitmap=bitmap;
+  if (!changedArea.hasArea())
+    return &UIArea::EMPTY;
+  UIPoint topLeft=dim.alignedTopLeft(alignment,&imageSize);
+  changedArea.set(topLeft.x+changedArea.left,topLeft.y+changedArea.top,topLeft.x+changedArea.right,topLeft.y+changedArea.bottom);
+  changedArea.intersectWith(&dim);
+  clip(display);
+  clearBox(display,&changedArea);
+  display->setClipWindow(changedArea.left,changedArea.top,changedArea.right,changedArea.bottom);
+  display->setDrawColor(1);
+  display->setBitmapMode(1);
+  if (format==UIBitmapFormat::Tiles)
+    drawTiles(display,&topLeft,&imageSize,bitmap);
+  else
+    display->drawXBMP(topLeft.x,topLeft.y,imageSize.width,imageSize.height,bitmap);
+  return &changedArea;
+}
+
+uint16_t UISprite::frameBytes() {
+  if (format==UIBitmapFormat::Tiles)
+    return imageSize.width*((imageSize.height+7)/8);
+  else
+    return ((imageSize.width+7)/8)*imageSize.height;
+}
+
+/* Compare both frames byte by byte, the differing bits of a byte give the exact pixel range */
+void UISprite::computeChangedArea() {
+  changedArea.clear();
+  if (!renderedBitmap)
+    return;
+  bool tiles=(format==UIBitmapFormat::Tiles);
+  uint16_t lineBytes=(tiles?imageSize.width:(imageSize.width+7)/8);
+  uint16_t count=frameBytes();
+  for (uint16_t i=0;i<count;i++) {
+    uint8_t diff=pgm_read_byte(renderedBitmap+i)^pgm_read_byte(bitmap+i);
+    if (diff) {
+      uint8_t low=0,high=7;
+      while (!(diff&(1<<low)))
+        low++;
+      while (!(diff&(1<<high)))
+        high--;
+      uint16_t line=i/lineBytes,column=i%lineBytes;
+      UIArea changed=(tiles?UIArea(column,line*8+low,column+1,line*8+high+1):UIArea(column*8+low,line,column*8+high+1,line+1));
+      changedArea.uniteWith(&changed);
+    }
+  }
+  changedArea.right=min(changedArea.right,imageSize.width);  // XBMP lines may contain unused bits
+}
+
+// end of file
@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// (C) 2023 Dirk Hillbrecht
+
+#pragma once
+
+#include "Arduino.h"
+#include <U8g2lib.h>
+
+#include "UIEnums.h"
+#include "UISize.h"
+#include "UIArea.h"
+#include "UIWidget.h"
+#include "UIBitmap.h"
+
+
+/** A bitmap showing one of several frames of an atlas, e.g. for spinners or battery levels.
+ *
+ * The atlas is one array in PROGMEM containing all frames of the same size one after the other,
+ * either in XBMP or in Tiles format (see UIBitmap). RLETiles is not supported as its frames differ in size,
+ * a sprite created with it shows the bitmap as one single frame and ignores setFrame().
+ *
+ *     UISprite battery=UISprite(16,8,battery_bits,5);
+ *     ...
+ *     battery.setFrame(level);
+ *
+ * Switching the frame renders only the pixels which differ between the old and the new frame:
+ * The widget compares both frames and clears and draws only the enclosing box of the changes.
+ * This is much cheaper than switching between several UIBitmap widgets in a UICards.
+ */
+class UISprite : public UIBitmap {
+
+  public:
+
+    /** Create a sprite with supplied format, alignment and potential successor.
+     *
+     * The supplied width and height are those of one frame, the atlas must contain frameCount frames.
+     * With UIBitmapFormat::RLETiles, frameCount is ignored and the atlas is one frame. */
+    UISprite(UICoordinate width,UICoordinate height,const uint8_t *atlas,uint8_t frameCount,UIBitmapFormat format,UIAlignment alignment,UIWidget* next=nullptr);
+
+    /** Create a sprite from an XBMP atlas with default centered alignment and potential successor. */
+    UISprite(UICoordinate width,UICoordinate height,const uint8_t *atlas,uint8_t frameCount,UIWidget* next=nullptr);
+
+    /** Show the frame with the given index, starting at 0. Indexes beyond the last frame are ignored. */
+    void setFrame(uint8_t index);
+
+    /** Return the index of the currently shown frame. */
+    uint8_t getFrame();
+
+    /** Render the complete frame if forced, otherwise only the changes since the last rendered frame. */
+    UIArea* render(U8G2* display,bool force);
+
+  private:
+
+    /** Index of the current frame */
+    uint8_t frame;
+
+    /** Number of frames in the atlas */
+    uint8_t frameCount;
+
+    /** Bitmap data of the last rendered frame */
+    const uint8_t* renderedBitmap;
+
+    /** Enclosure of the pixels changed by the last frame switch */
+    UIArea changedArea;
+
+    /** Return the number of bytes of one frame. */
+    uint16_t frameBytes();
+
+    /** Compute the enclosure of all pixels differing between the rendered and the current frame, relative to the frame. */
+    void computeChangedArea();
+
+};
+
+// end of file
@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// (C) 2023 Dirk Hillbrecht
+
+#pragma once
+
+#include "Arduino.h"
+#include <U8g2lib.h>
+
+#include "UISize.h"
+#include "UIArea.h"
+#include "UIWidget.h"
+#include "UIWidgetGroup.h"
+#include "UIStaticLengths.h"
+
+/** Widget group for widgets organized in columns whose widths are known at compile time.
+ *
+ * This is the column-wise counterpart of UIStaticRows: The widths of the columns are given
+ * as template parameters, either in pixels or as UISize::MAX_LEN for "as wide as possible":
+ *
+ *     UIStaticColumns<UISize::MAX_LEN,24> top=UIStaticColumns<UISize::MAX_LEN,24>(&mainArea);
+ *
+ * The widths are stored in flash memory, their sum and the number of extending columns are
+ * computed by the compiler. The preferred height is still taken from the sub-widgets,
+ * see UIStaticRows for the limits of compile-time layout.
+ */
+template<uint16_t... widths>
+class UIStaticColumns: public UIWidgetGroup {
+
+  public:
+
+    /** Create a group of column-wise arranged sub-widgets with the widths given as template parameters. */
+    UIStaticColumns(UIWidget* firstChild,UIWidget* next=nullptr): UIWidgetGroup(firstChild,next) {}
+
+    /** Layout all the sub-widgets one next to the other, using the widths given at compile time. */
+    void layout(U8G2* display,UIArea* dim) {
+      UIWidgetGroup::layout(display,dim);
+      UIArea stamp=UIArea(dim);
+      stamp.right=stamp.left;
+      uint16_t width=dim->right-dim->left;
+      uint16_t extendingWidth=(Lengths::EXTENDING==0 || Lengths::FIXED>=width?0:(width-Lengths::FIXED)/Lengths::EXTENDING);
+      UIWidget* widget=firstChild;
+      for (uint8_t i=0;widget;i++) {
+        if (i<Lengths::COUNT) {
+          uint16_t requestedWidth=pgm_read_word(&WIDTHS[i]);
+          stamp.right=min((int)dim->right,stamp.right+(requestedWidth==UISize::MAX_LEN?extendingWidth:requestedWidth));
+        }
+        layoutChild(display,widget,&stamp);
+        widget=widget->next;
+        stamp.left=stamp.right;
+      }
+    }
+
+  protected:
+
+    /** Preferred width is known at compile time, preferred height is the maximum of the sub-widgets' heights. */
+    void computePreferredSize(U8G2 *display,UISize *preferredSize) {
+      UICoordinate height=0;
+      UIWidget* elem=firstChild;
+      while (elem) {  // sub-widgets are asked anyway as they may initialize themselves in this step
+        height=UISize::my_max(height,elem->preferredSize(display).height);
+        elem=elem->next;
+      }
+      preferredSize->set((Lengths::EXTENDING>0?UISize::MAX_LEN:UISize::max_len_or(Lengths::FIXED)),height);
+    }
+
+  private:
+
+    /** Compile-time evaluation of the widths. */
+    typedef UIStaticLengths<widths...> Lengths;
+
+    /** The widths of the columns in flash memory. */
+    static const uint16_t WIDTHS[sizeof...(widths)] PROGMEM;
+
+};
+
+template<uint16_t... widths>
+const uint16_t UIStaticColumns<widths...>::WIDTHS[sizeof...(widths)] PROGMEM={widths...};
+
+// end of file
@@ -0,0 +1,35 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// (C) 2023 Dirk Hillbrecht
+
+#pragma once
+
+#include "Arduino.h"
+
+#include "UISize.h"
+
+/** Compile-time evaluation of a list of lengths for UIStaticRows and UIStaticColumns.
+ *
+ * Each length is either a fixed number of pixels or UISize::MAX_LEN for "as large as possible".
+ * FIXED is the sum of all fixed lengths, EXTENDING the number of "as large as possible" lengths.
+ * Both are computed by the compiler, they need neither RAM nor any computation at runtime.
+ */
+template<uint16_t... lengths>
+struct UIStaticLengths;
+
+/** End of recursion: The empty list of lengths. */
+template<>
+struct UIStaticLengths<> {
+  static const uint16_t FIXED=0;
+  static const uint8_t EXTENDING=0;
+  static const uint8_t COUNT=0;
+};
+
+/** Recursion: First length plus the evaluation of the rest. */
+template<uint16_t first,uint16_t... rest>
+struct UIStaticLengths<first,rest...> {
+  static const uint16_t FIXED=(first==UISize::MAX_LEN?0:first)+UIStaticLengths<rest...>::FIXED;
+  static const uint8_t EXTENDING=(first==UISize::MAX_LEN?1:0)+UIStaticLengths<rest...>::EXTENDING;
+  static const uint8_t COUNT=1+UIStaticLengths<rest...>::COUNT;
+};
+
+// end of file
@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// (C) 2023 Dirk Hillbrecht
+
+#pragma once
+
+#include "Arduino.h"
+#include <U8g2lib.h>
+
+#include "UISize.h"
+#include "UIArea.h"
+#include "UIWidget.h"
+#include "UIWidgetGroup.h"
+#include "UIStaticLengths.h"
+
+/** Widget group for widgets organized in rows whose heights are known at compile time.
+ *
+ * This is a variant of UIRows for completely static interfaces. The heights of the rows
+ * are given as template parameters, either in pixels or as UISize::MAX_LEN for
+ * "as high as possible":
+ *
+ *     UIStaticRows<12,UISize::MAX_LEN,12> screen=UIStaticRows<12,UISize::MAX_LEN,12>(&header);
+ *
+ * The heights are stored in flash memory, their sum and the number of extending rows are
+ * computed by the compiler. So, in contrast to UIRows, this group needs no RAM besides that of
+ * UIWidgetGroup, and it does not ask its sub-widgets for their preferred heights in the layout step.
+ * Sub-widgets beyond the given number of heights get an empty area.
+ *
+ * Note that the complete geometry can not be computed at compile time: Font metrics, and therefore
+ * the heights of text lines, are only known to U8g2 at runtime, and the display size is known only
+ * to the U8g2 instance. Therefore, the preferred width is still taken from the sub-widgets and
+ * layout still happens in UIDisplay::init(), it is just much simpler.
+ */
+template<uint16_t... heights>
+class UIStaticRows: public UIWidgetGroup {
+
+  public:
+
+    /** Create a group of row-wise arranged sub-widgets with the heights given as template parameters. */
+    UIStaticRows(UIWidget* firstChild,UIWidget* next=nullptr): UIWidgetGroup(firstChild,next) {}
+
+    /** Layout all the sub-widgets one below the other, using the heights given at compile time. */
+    void layout(U8G2* display,UIArea* dim) {
+      UIWidgetGroup::layout(display,dim);
+      UIArea stamp=UIArea(dim);
+      stamp.bottom=stamp.top;
+      uint16_t height=dim->bottom-dim->top;
+      uint16_t extendingHeight=(Lengths::EXTENDING==0 || Lengths::FIXED>=height?0:(height-Lengths::FIXED)/Lengths::EXTENDING);
+      UIWidget* widget=firstChild;
+      for (uint8_t i=0;widget;i++) {
+        if (i<Lengths::COUNT) {
+          uint16_t requestedHeight=pgm_read_word(&HEIGHTS[i]);
+          stamp.bottom=min((int)dim->bottom,stamp.bottom+(requestedHeight==UISize::MAX_LEN?extendingHeight:requestedHeight));
+        }
+        layoutChild(display,widget,&stamp);
+        widget=widget->next;
+        stamp.top=stamp.bottom;
+      }
+    }
+
+  protected:
+
+    /** Preferred height is known at compile time, preferred width is the maximum of the sub-widgets' widths. */
+    void computePreferredSize(U8G2 *display,UISize *preferredSize) {
+      UICoordinate width=0;
+      UIWidget* elem=firstChild;
+      while (elem) {  // sub-widgets are asked anyway as they may initialize themselves in this step
+        width=UISize::my_max(width,elem->preferredSize(display).width);
+        elem=elem->next;
+      }
+      preferredSize->set(width,(Lengths::EXTENDING>0?UISize::MAX_LEN:UISize::max_len_or(Lengths::FIXED)));
+    }
+
+  private:
+
+    /** Compile-time evaluation of the heights. */
+    typedef UIStaticLengths<heights...> Lengths;
+
+    /** The heights of the rows in flash memory. */
+    static const uint16_t HEIGHTS[sizeof...(heights)] PROGMEM;
+
+};
+
+template<uint16_t... heights>
+const uint16_t UIStaticRows<heights...>::HEIGHTS[sizeof...(heights)] PROGMEM={heights...};
+
+// end of file
@@ -0,0 +1,52 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// (C) 2023 Dirk Hillbrecht
+
+#include "Arduino.h"
+#include "UIConfig.h"
+#include "UIStatistics.h"
+
+/* Initialize statistics with all counters 0. */
+UIWidgetStatistics::UIWidgetStatistics() {
+  reset();
+}
+
+void UIWidgetStatistics::reset() {
+  renderCalls=0;renderMicros=0;maxRenderMicros=0;
+  renderedAreas=0;renderedPixels=0;
+}
+
+void UIWidgetStatistics::debugPrint(const char* label) {
+  Serial.print(label);Serial.print("(calls=");
+  Serial.print(renderCalls);Serial.print(",us=");
+  Serial.print(renderMicros);Serial.print(",maxUs=");
+  Serial.print(maxRenderMicros);Serial.print(",areas=");
+  Serial.print(renderedAreas);Serial.print(",pixels=");
+  Serial.print(renderedPixels);Serial.println(")");
+}
+
+/* Initialize statistics with all counters 0. */
+UIDisplayStatistics::UIDisplayStatistics() {
+  reset();
+}
+
+void UIDisplayStatistics::reset() {
+  renderCalls=0;renderCycles=0;deferredUpdateCycles=0;
+  tilesSent=0;bytesSent=0;tilesSkipped=0;transfers=0;transferMicros=0;
+  maxRenderMicros=0;maxUpdateLatencyMicros=0;
+}
+
+void UIDisplayStatistics::debugPrint(const char* label) {
+  Serial.print(label);Serial.print("(calls=");
+  Serial.print(renderCalls);Serial.print(",cycles=");
+  Serial.print(renderCycles);Serial.print(",deferred=");
+  Serial.print(deferredUpdateCycles);Serial.print(",tiles=");
+  Serial.print(tilesSent);Serial.print(",bytes=");
+  Serial.print(bytesSent);Serial.print(",skipped=");
+  Serial.print(tilesSkipped);Serial.print(",transfers=");
+  Serial.print(transfers);Serial.print(",transferUs=");
+  Serial.print(transferMicros);Serial.print(",maxRenderUs=");
+  Serial.print(maxRenderMicros);Serial.print(",maxLatencyUs=");
+  Serial.print(maxUpdateLatencyMicros);Serial.println(")");
+}
+
+// end of file
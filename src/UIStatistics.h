@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// (C) 2023 Dirk Hillbrecht
+
+#pragma once
+
+#include "Arduino.h"
+#include "UIConfig.h"
+
+/** Render statistics of one widget.
+ *
+ * Only available if UIUIUI_STATISTICS is enabled in UIConfig.h.
+ * Times include the rendering of all sub-widgets for widget groups,
+ * areas and pixels are only counted for the widget which actually reported them.
+ */
+class UIWidgetStatistics final {
+  public:
+
+    /** Initialize statistics with all counters 0. */
+    UIWidgetStatistics();
+
+    /** Reset all counters to 0. */
+    void reset();
+
+    /** Number of calls to render the widget. */
+    uint32_t renderCalls;
+
+    /** Sum of the time spent in rendering the widget, in microseconds. */
+    uint32_t renderMicros;
+
+    /** Longest time spent in one rendering of the widget, in microseconds. */
+    uint32_t maxRenderMicros;
+
+    /** Number of non-empty areas the widget has reported as changed. */
+    uint32_t renderedAreas;
+
+    /** Sum of the pixels in all areas the widget has reported as changed. */
+    uint32_t renderedPixels;
+
+    /** Debug output of these statistics with some prepended label. */
+    void debugPrint(const char* label);
+
+};
+
+/** Render and display update statistics of one UIDisplay.
+ *
+ * Only available if UIUIUI_STATISTICS is enabled in UIConfig.h.
+ */
+class UIDisplayStatistics final {
+  public:
+
+    /** Initialize statistics with all counters 0. */
+    UIDisplayStatistics();
+
+    /** Reset all counters to 0. */
+    void reset();
+
+    /** Number of calls to UIDisplay::render(). */
+    uint32_t renderCalls;
+
+    /** Number of render() calls in which the widgets have actually been rendered. */
+    uint32_t renderCycles;
+
+    /** Number of render() calls which only sent tiles deferred from earlier rendering. */
+    uint32_t deferredUpdateCycles;
+
+    /** Number of tiles sent to the display. */
+    uint32_t tilesSent;
+
+    /** Number of tile bytes sent to the display (8 per tile, without any protocol overhead). */
+    uint32_t bytesSent;
+
+    /** Number of tiles not sent as their content had not changed (see UIDisplay::setTileChecksums()). */
+    uint32_t tilesSkipped;
+
+    /** Number of transfers to the display, i.e. calls to U8G2::updateDisplayArea(). */
+    uint32_t transfers;
+
+    /** Sum of the time spent in transferring tiles to the display, in microseconds. */
+    uint32_t transferMicros;
+
+    /** Longest time spent in one call to UIDisplay::render(), in microseconds. */
+    uint32_t maxRenderMicros;
+
+    /** Longest time from rendering until all rendered tiles are on the display, in microseconds. */
+    uint32_t maxUpdateLatencyMicros;
+
+    /** Debug output of these statistics with some prepended label. */
+    void debugPrint(const char* label);
+
+};
+
+// end of file
@@ -10,10 +10,13 @@
 #include "UIArea.h"
 #include "UIWidget.h"
 #include "UITextLine.h"
+#include "UITextWidthCache.h"
 
 /* Create a text line with the given font, alignment, UTF8 flag and a potential successor. */
 UITextLine::UITextLine(const uint8_t* font,UIAlignment alignment,bool useUTF8,UIWidget* next):
-  UIWidget(next),font(font),text(""),alignment(alignment),useUTF8(useUTF8),changed(false) {}
+  UIWidget(next),font(font),text(""),alignment(alignment),useUTF8(useUTF8),changed(false),
+  glyphOffsets(nullptr),glyphOffsetCount(0),glyphOffsetsValid(false),partialChange(false),
+  minUpdateInterval(0),lastUpdateMillis(0) {}
 
 /* Create a text line with the given font and alignment and a potential successor. */
 UITextLine::UITextLine(const uint8_t* font,UIAlignment alignment,UIWidget* next):
@@ -34,12 +37,45 @@ UITextLine::UITextLine(const uint8_t* font):
 void UITextLine::setText(const char* text) {
   // Only do something if the new text differs from the current one.
   if (this->text!=text) {
-    if (strcmp(this->text,text) != 0)
+    if (strcmp(this->text,text) != 0) {
+      // Check whether only some characters of a text of the same length have changed
+      bool partial=(glyphOffsetsValid && (partialChange || !changed));
+      uint8_t start=0,end=0;
+      if (partial) {
+        size_t length=strlen(text);
+        partial=(length<glyphOffsetCount && strlen(this->text)==length);
+        if (partial) {
+          while (this->text[start]==text[start])
+            start++;
+          end=length;
+          while (this->text[end-1]==text[end-1])
+            end--;
+        }
+      }
+      UICoordinate width=textSize.width;
+      bool merge=(partialChange && changed);
       this->updateText();
+      if (partial) {  // Keep the layout, remember the range of changed characters
+        textSize.width=width;
+        diffStart=(merge?min(diffStart,start):start);
+        diffEnd=(merge?max(diffEnd,end):end);
+        partialChange=true;
+      }
+    }
     this->text=text;
   }
 }
 
+void UITextLine::setGlyphOffsets(uint8_t* offsets,uint8_t count) {
+  glyphOffsets=offsets;
+  glyphOffsetCount=count;
+  glyphOffsetsValid=false;  // offsets are computed with the next complete rendering
+}
+
+void UITextLine::setMinUpdateInterval(uint16_t millis) {
+  minUpdateInterval=millis;
+}
+
 void UITextLine::clearText() {
   setText("");
 }
@@ -47,6 +83,7 @@ void UITextLine::clearText() {
 void UITextLine::updateText() {
   lastArea.set(&thisArea);  // Remember the last (rendered) content area
   textSize.width=0;
+  partialChange=false;
   changed=true;
   signalNeedsRendering();
 }
@@ -55,8 +92,21 @@ UIArea* UITextLine::render(U8G2* display,bool force) {
   // Only do something if a change has occured or rendering is forced
   //   AND there is actually an area to render to.
   if ((changed || force) && dim.hasArea()) {
+    if (!force && minUpdateInterval>0) {
+      uint32_t elapsed=millis()-lastUpdateMillis;
+      if (elapsed<minUpdateInterval) {  // too early: keep the change and ask to be rendered later
+        signalDefersRendering(&dim,minUpdateInterval-elapsed);
+        return &UIArea::EMPTY;
+      }
+    }
+    lastUpdateMillis=millis();
     changed=false;  // As we render now, there is no change to what is rendered
     clip(display);  // Clip every drawing to the frame buffer to this component's area.
+    if (partialChange && !force && renderChangedGlyphs(display)) {
+      partialChange=false;
+      return &diffArea;
+    }
+    partialChange=false;
     if (lastArea.hasArea())
       clearBox(display,&lastArea); // Clear the area of the last rendered content of this text line
     if (sizeof(text)>0) { // If there is a text to be drawn
@@ -64,7 +114,7 @@ UIArea* UITextLine::render(U8G2* display,bool force) {
       display->setFont(font);
       display->setFontDirection(0);
       if (textSize.width==0) {  // Text width has not yet been computed
-        textSize.width=(useUTF8?display->getUTF8Width(text):display->getStrWidth(text));
+        textSize.width=UISize::max_len_or(UITextWidthCache::getWidth(display,font,text,useUTF8));
         topLeft.setFrom(dim.alignedTopLeft(alignment,&textSize));
       }
       display->setDrawColor(1); // Setup painting
@@ -74,9 +124,10 @@ UIArea* UITextLine::render(U8G2* display,bool force) {
       else
         display->drawStr(topLeft.x,topLeft.y,text);  // Draw the text
       // Store the current text's area
-      thisArea.set(topLeft.x,topLeft.y,topLeft.x+textSize.width,topLeft.y+textSize.height);
+      thisArea.set(&topLeft,&textSize);
       thisArea.intersectWith(&dim);
       lastArea.uniteWith(&thisArea); // Old and current text area together are where this component has rendered things.
+      computeGlyphOffsets(display);
     }
     return &lastArea;
   }
@@ -84,13 +135,70 @@ UIArea* UITextLine::render(U8G2* display,bool force) {
     return &UIArea::EMPTY;
 } // render()
 
+bool UITextLine::renderChangedGlyphs(U8G2* display) {
+  display->setFontPosTop();
+  display->setFont(font);
+  display->setFontDirection(0);
+  // The text must keep its width, otherwise alignment moves everything
+  if (UISize::max_len_or(UITextWidthCache::getWidth(display,font,text,false))!=textSize.width) {
+    textSize.width=0;
+    return false;
+  }
+  // The changed characters must keep their positions
+  u8g2_t *u8g2=display->getU8g2();
+  uint16_t x=glyphOffsets[diffStart];
+  for (uint8_t i=diffStart;i<diffEnd;i++)
+    x+=u8g2_GetGlyphWidth(u8g2,(uint8_t)text[i]);
+  if (x!=glyphOffsets[diffEnd]) {
+    textSize.width=0;
+    return false;
+  }
+  for (uint8_t i=diffStart;i<diffEnd;i++)
+    glyphOffsets[i+1]=glyphOffsets[i]+u8g2_GetGlyphWidth(u8g2,(uint8_t)text[i]);
+  // Redraw the changed characters and their neighbours, glyphs may exceed their advance width a bit
+  uint8_t length=strlen(text);
+  uint8_t first=(diffStart>0?diffStart-1:0);
+  uint8_t last=(diffEnd<length?diffEnd+1:length);
+  diffArea.set(topLeft.x+glyphOffsets[first],topLeft.y,
+      topLeft.x+(last==length?max((UICoordinate)glyphOffsets[last],textSize.width):glyphOffsets[last]),topLeft.y+textSize.height);
+  diffArea.intersectWith(&dim);
+  if (!diffArea.hasArea())
+    return true;
+  clearBox(display,&diffArea);
+  display->setClipWindow(diffArea.left,diffArea.top,diffArea.right,diffArea.bottom);
+  display->setDrawColor(1);
+  display->setBitmapMode(1);
+  for (uint8_t i=(first>0?first-1:0);i<last+(last<length?1:0);i++)
+    display->drawGlyph(topLeft.x+glyphOffsets[i],topLeft.y,(uint8_t)text[i]);
+  return true;
+}
+
+void UITextLine::computeGlyphOffsets(U8G2* display) {
+  glyphOffsetsValid=false;
+  if (!glyphOffsets || useUTF8)
+    return;
+  u8g2_t *u8g2=display->getU8g2();
+  uint16_t x=0;
+  uint8_t i=0;
+  for (;text[i];i++) {
+    if (i+1>=glyphOffsetCount || x>0xff)
+      return;
+    glyphOffsets[i]=x;
+    x+=u8g2_GetGlyphWidth(u8g2,(uint8_t)text[i]);
+  }
+  if (x>0xff)
+    return;
+  glyphOffsets[i]=x;
+  glyphOffsetsValid=true;
+}
+
 void UITextLine::computePreferredSize(U8G2 *display,UISize *preferredSize) {
   display->setFont(font);
   display->setFontRefHeightExtendedText();
   preferredSize->set(UISize::MAX_LEN,getTextHeight(display));
 }
 
-uint16_t UITextLine::getTextHeight(U8G2* display) {
+UICoordinate UITextLine::getTextHeight(U8G2* display) {
   if (textSize.height==0) {
     display->setFont(font);
     display->setFontRefHeightExtendedText();
@@ -60,6 +60,31 @@ class UITextLine : public UIWidget {
      */
     void updateText();
 
+    /** Enable or disable redrawing only the changed characters of the text.
+     *
+     * Normally, a text line clears and redraws its whole text whenever it changes.
+     * If a new text has the same length as the old one and the changed characters have the
+     * same width as the old ones (e.g. digits of a clock in most fonts), it is much cheaper
+     * to redraw only the changed characters. This needs the horizontal offset of each character,
+     * which the text line stores in the given buffer. It must have room for one entry more
+     * than the longest text. Longer texts, UTF8 texts and texts wider than 255 pixels are
+     * always redrawn completely.
+     *
+     * @param offsets Buffer for the character offsets, nullptr to always redraw the whole text.
+     * @param count Number of entries in the buffer.
+     */
+    void setGlyphOffsets(uint8_t* offsets=nullptr,uint8_t count=0);
+
+    /** Set the minimum time between two renderings of a changed text.
+     *
+     * If the text changes faster, e.g. with every reading of a fast sensor, the text line
+     * renders the newest text only when the interval has passed since its last update on the display.
+     * Changes in between are not shown at all. Forced rendering is not affected.
+     *
+     * @param millis Minimum time in milliseconds between two updates, 0 (default) for no limit
+     */
+    void setMinUpdateInterval(uint16_t millis=0);
+
     /** Render the text line.
      *
      * This method is carefully designed so that it only draws and changes those parts of
@@ -100,10 +125,43 @@ class UITextLine : public UIWidget {
     /** Area of the text which is currently rendered by this text line. */
     UIArea thisArea;
 
+    /** Horizontal offsets of the characters of the rendered text relative to topLeft, nullptr if not used. */
+    uint8_t* glyphOffsets;
+
+    /** Number of entries in glyphOffsets. */
+    uint8_t glyphOffsetCount;
+
+    /** Flag whether glyphOffsets describe the currently rendered text. */
+    bool glyphOffsetsValid;
+
+    /** Flag whether only the characters from diffStart to diffEnd have changed since the last rendering. */
+    bool partialChange;
+
+    /** Index of the first changed character. */
+    uint8_t diffStart;
+
+    /** Index after the last changed character. */
+    uint8_t diffEnd;
+
+    /** Area of the characters redrawn in the last partial rendering. */
+    UIArea diffArea;
+
+    /** Minimum time in milliseconds between two renderings of a changed text, 0 for no limit */
+    uint16_t minUpdateInterval;
+
+    /** Time of the last rendering of a changed text */
+    uint32_t lastUpdateMillis;
+
+    /** Try to redraw only the changed characters, return false if the whole text must be redrawn. */
+    bool renderChangedGlyphs(U8G2* display);
+
+    /** Store the character offsets of the current text into glyphOffsets if possible. */
+    void computeGlyphOffsets(U8G2* display);
+
     /** Compute the text height and return it.
      *
      * NOTE: This method works with an internal side effect into the textSize field. */
-    uint16_t getTextHeight(U8G2* display);
+    UICoordinate getTextHeight(U8G2* display);
 
 };
 
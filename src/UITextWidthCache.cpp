@@ -0,0 +1,63 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// (C) 2023 Dirk Hillbrecht
+
+#include "Arduino.h"
+#include <U8g2lib.h>
+
+#include "UIConfig.h"
+#include "UITextWidthCache.h"
+
+#if UIUIUI_TEXT_WIDTH_CACHE_SIZE>0
+
+UITextWidthCache::Entry UITextWidthCache::entries[UIUIUI_TEXT_WIDTH_CACHE_SIZE];
+
+uint8_t UITextWidthCache::count=0;
+
+uint16_t UITextWidthCache::getWidth(U8G2* display,const uint8_t* font,const char* text,bool useUTF8) {
+  uint32_t hash=hashOf(text);
+  uint8_t i=0;
+  while (i<count && !(entries[i].hash==hash && entries[i].font==font && entries[i].useUTF8==useUTF8))
+    i++;
+  Entry entry;
+  if (i<count)  // hit
+    entry=entries[i];
+  else {  // miss: compute width, the last entry is dropped if the cache is full
+    entry.font=font;
+    entry.hash=hash;
+    entry.width=(useUTF8?display->getUTF8Width(text):display->getStrWidth(text));
+    entry.useUTF8=useUTF8;
+    if (count<UIUIUI_TEXT_WIDTH_CACHE_SIZE)
+      count++;
+    i=count-1;
+  }
+  // Move the entry to the front
+  for (;i>0;i--)
+    entries[i]=entries[i-1];
+  entries[0]=entry;
+  return entry.width;
+}
+
+void UITextWidthCache::clear() {
+  count=0;
+}
+
+uint32_t UITextWidthCache::hashOf(const char* text) {
+  uint32_t hash=2166136261UL;
+  while (*text) {
+    hash^=(uint8_t)*text++;
+    hash*=16777619UL;
+  }
+  return hash;
+}
+
+#else
+
+uint16_t UITextWidthCache::getWidth(U8G2* display,const uint8_t* font,const char* text,bool useUTF8) {
+  return (useUTF8?display->getUTF8Width(text):display->getStrWidth(text));
+}
+
+void UITextWidthCache::clear() {}
+
+#endif
+
+// end of file
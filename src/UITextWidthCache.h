@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// (C) 2023 Dirk Hillbrecht
+
+#pragma once
+
+#include "Arduino.h"
+#include <U8g2lib.h>
+
+#include "UIConfig.h"
+
+/** Cache of the widths of recently rendered texts.
+ *
+ * Computing the width of a text means walking through the font data glyph by glyph.
+ * Sketches often cycle through a small set of texts, e.g. some status messages, and
+ * compute the same widths again and again. This cache remembers the widths of the last
+ * UIUIUI_TEXT_WIDTH_CACHE_SIZE texts (see UIConfig.h) for all text lines together.
+ *
+ * Texts are identified by font, UTF8 flag and a hash of their content,
+ * the least recently used entry is replaced if the cache is full.
+ *
+ * All members are static, there are no instances of this class.
+ */
+class UITextWidthCache final {
+
+  public:
+
+    /** Return the width of the text, the text's font must already be set on the display.
+     *
+     * @param display The display to compute the width with if it is not cached
+     * @param font The font of the text
+     * @param text The text to get the width of
+     * @param useUTF8 Flag whether the text is UTF8 encoded
+     */
+    static uint16_t getWidth(U8G2* display,const uint8_t* font,const char* text,bool useUTF8);
+
+    /** Remove all entries from the cache. */
+    static void clear();
+
+  private:
+
+#if UIUIUI_TEXT_WIDTH_CACHE_SIZE>0
+    /** One cached text width */
+    struct Entry {
+      const uint8_t* font;
+      uint32_t hash;
+      uint16_t width;
+      bool useUTF8;
+    };
+
+    /** The cached widths, most recently used first */
+    static Entry entries[UIUIUI_TEXT_WIDTH_CACHE_SIZE];
+
+    /** Number of valid entries */
+    static uint8_t count;
+
+    /** Return the FNV-1a hash of the text. */
+    static uint32_t hashOf(const char* text);
+#endif
+
+};
+
+// end of file
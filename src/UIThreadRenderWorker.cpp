@@ -0,0 +1,60 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// (C) 2023 Dirk Hillbrecht
+
+#include "Arduino.h"
+#include <U8g2lib.h>
+
+#include "UIConfig.h"
+#include "UIThreadRenderWorker.h"
+
+#if UIUIUI_STD_THREAD
+
+#include <chrono>
+
+UIThreadRenderWorker::UIThreadRenderWorker(): UIRenderWorker(), woken(false), stopping(false) {}
+
+UIThreadRenderWorker::~UIThreadRenderWorker() {
+  stop();
+}
+
+void UIThreadRenderWorker::start(UIDisplay* display,U8G2* u8g2) {
+  this->display=display;
+  this->u8g2=u8g2;
+  stopping=false;
+  woken=true;  // render whatever has been changed before the start
+  thread=std::thread([this]{ run(); });
+}
+
+void UIThreadRenderWorker::stop() {
+  if (!thread.joinable())
+    return;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping=true;
+  }
+  condition.notify_one();
+  thread.join();
+}
+
+void UIThreadRenderWorker::wake() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    woken=true;
+  }
+  condition.notify_one();
+}
+
+bool UIThreadRenderWorker::waitForWake() {
+  std::unique_lock<std::mutex> lock(mutex);
+  condition.wait(lock,[this]{ return woken || stopping; });
+  woken=false;
+  return !stopping;
+}
+
+void UIThreadRenderWorker::pause(uint32_t millis) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(millis));
+}
+
+#endif
+
+// end of file
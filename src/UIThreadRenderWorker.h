@@ -0,0 +1,75 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// (C) 2023 Dirk Hillbrecht
+
+#pragma once
+
+#include "Arduino.h"
+#include <U8g2lib.h>
+
+#include "UIConfig.h"
+#include "UIRenderWorker.h"
+
+#if UIUIUI_STD_THREAD
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+/** Render worker running on a std::thread.
+ *
+ * This implementation works wherever the C++ standard library offers threads, e.g. on the host
+ * for testing the interface without hardware or on the ESP32 where std::thread is mapped to FreeRTOS.
+ * It cannot pin the thread to a core and std::thread allocates its stack on the heap,
+ * so prefer UIFreeRTOSRenderWorker on microcontrollers.
+ *
+ * Only available if UIUIUI_STD_THREAD is set, see UIConfig.h.
+ */
+class UIThreadRenderWorker: public UIRenderWorker {
+
+  public:
+
+    /** Create a thread render worker, the thread is created on start(). */
+    UIThreadRenderWorker();
+
+    /** Stop the thread if it is still running. */
+    ~UIThreadRenderWorker();
+
+    /** Start the thread rendering the given display. */
+    void start(UIDisplay* display,U8G2* u8g2);
+
+    /** Let the thread finish its current rendering and wait until it has ended. */
+    void stop();
+
+    /** Wake the thread so that it renders the display. */
+    void wake();
+
+  protected:
+
+    /** Wait on the condition variable until woken or stopped. */
+    bool waitForWake();
+
+    /** Sleep for the given time. */
+    void pause(uint32_t millis);
+
+  private:
+
+    /** The rendering thread */
+    std::thread thread;
+
+    /** Mutex protecting woken and stopping */
+    std::mutex mutex;
+
+    /** Condition signalled on wake() and stop() */
+    std::condition_variable condition;
+
+    /** Flag whether wake() has been called since the last wait */
+    bool woken;
+
+    /** Flag whether the thread must end */
+    bool stopping;
+
+};
+
+#endif
+
+// end of file
@@ -0,0 +1,48 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// (C) 2023 Dirk Hillbrecht
+
+#pragma once
+
+#include "Arduino.h"
+#include <U8g2lib.h>
+
+#include "UIArea.h"
+
+/** Abstraction of a non-blocking transfer of tiles from the frame buffer to the display.
+ *
+ * Normally, UIDisplay sends tiles synchronously by calling U8G2::updateDisplayArea().
+ * The CPU waits while the bytes go out over I2C or SPI then.
+ *
+ * If a UITransfer is set with UIDisplay::setTransfer(), UIDisplay hands the tiles to it instead.
+ * An implementation starts the transfer (e.g. via DMA, interrupts or some background task)
+ * and returns immediately. UIDisplay asks it later with isTransferring() whether it has finished.
+ *
+ * While a transfer is running, UIDisplay neither renders into the frame buffer nor starts
+ * another transfer, so the tiles in flight keep their content until they are sent.
+ *
+ * This pure virtual class only defines the interface. UISimulatedTransfer is an implementation
+ * which simulates some transfer latency without any special hardware.
+ */
+class UITransfer {
+
+  public:
+
+    /** Start transferring the given area of tiles to the display and return immediately.
+     *
+     * This is only called if no other transfer is running.
+     *
+     * @param display The U8g2 display to send the tiles to
+     * @param buffer The frame buffer containing the tiles, do not rely on the display's buffer pointer
+     * @param tiles The area of tiles to transfer, it is only valid during this call
+     */
+    virtual void startTransfer(U8G2* display,uint8_t* buffer,UIArea* tiles)=0;
+
+    /** Return whether the transfer started last is still running.
+     *
+     * UIDisplay polls this method. Implementations may use the call to advance the transfer.
+     */
+    virtual bool isTransferring(U8G2* display)=0;
+
+};
+
+// end of file
@@ -0,0 +1,149 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// (C) 2023 Dirk Hillbrecht
+
+#include "Arduino.h"
+
+#include "UIConfig.h"
+#include "UIWidget.h"
+#include "UITextLine.h"
+#include "UICards.h"
+#include "UISprite.h"
+#include "UIRenderWorker.h"
+#include "UIUpdateQueue.h"
+
+// head and tail are read and written with acquire/release semantics, so the update data
+// is complete in memory before the other side sees the changed index. On 8-bit CPUs,
+// these are plain byte accesses, on multi-core CPUs like the ESP32 they include memory barriers.
+
+UIUpdateQueue::UIUpdateQueue(UIUpdateQueue* next): head(0),tail(0),renderWorker(nullptr),next(next) {}
+
+bool UIUpdateQueue::setText(UITextLine* line,const char* text) {
+  Update* update=reserve();
+  if (!update)
+    return false;
+  update->type=SetText;
+  update->widget=line;
+  update->value.text=text;
+  publish();
+  return true;
+}
+
+#if UIUIUI_UPDATE_QUEUE_TEXT_SIZE>0
+bool UIUpdateQueue::copyText(UITextLine* line,char* buffer,const char* text) {
+  Update* update=reserve();
+  if (!update)
+    return false;
+  update->type=CopyText;
+  update->widget=line;
+  update->value.copy.buffer=buffer;
+  strncpy(update->value.copy.text,text,UIUIUI_UPDATE_QUEUE_TEXT_SIZE-1);
+  update->value.copy.text[UIUIUI_UPDATE_QUEUE_TEXT_SIZE-1]=0;
+  publish();
+  return true;
+}
+#endif
+
+bool UIUpdateQueue::updateText(UITextLine* line) {
+  Update* update=reserve();
+  if (!update)
+    return false;
+  update->type=UpdateText;
+  update->widget=line;
+  publish();
+  return true;
+}
+
+bool UIUpdateQueue::setVisibleWidget(UICards* cards,UIWidget* visible) {
+  Update* update=reserve();
+  if (!update)
+    return false;
+  update->type=SetVisibleWidget;
+  update->widget=cards;
+  update->value.visible=visible;
+  publish();
+  return true;
+}
+
+bool UIUpdateQueue::setFrame(UISprite* sprite,uint8_t index) {
+  Update* update=reserve();
+  if (!update)
+    return false;
+  update->type=SetFrame;
+  update->widget=sprite;
+  update->value.index=index;
+  publish();
+  return true;
+}
+
+bool UIUpdateQueue::invalidateLayout(UIWidget* widget) {
+  Update* update=reserve();
+  if (!update)
+    return false;
+  update->type=InvalidateLayout;
+  update->widget=widget;
+  publish();
+  return true;
+}
+
+bool UIUpdateQueue::isEmpty() {
+  for (UIUpdateQueue* queue=this;queue;queue=queue->next)
+    if (__atomic_load_n(&queue->head,__ATOMIC_ACQUIRE)!=queue->tail)
+      return false;
+  return true;
+}
+
+void UIUpdateQueue::apply() {
+  for (UIUpdateQueue* queue=this;queue;queue=queue->next)
+    queue->applyOwn();
+}
+
+void UIUpdateQueue::applyOwn() {
+  uint8_t posted=__atomic_load_n(&head,__ATOMIC_ACQUIRE);
+  while (tail!=posted) {
+    Update* update=&updates[tail%UIUIUI_UPDATE_QUEUE_SIZE];
+    switch (update->type) {
+      case SetText:
+        ((UITextLine*)update->widget)->setText(update->value.text);
+        break;
+      case CopyText:  // compare with the old text while it is intact, then move the line over to the buffer
+#if UIUIUI_UPDATE_QUEUE_TEXT_SIZE>0
+        ((UITextLine*)update->widget)->setText(update->value.copy.text);
+        strcpy(update->value.copy.buffer,update->value.copy.text);
+        ((UITextLine*)update->widget)->setText(update->value.copy.buffer);
+#endif
+        break;
+      case UpdateText:
+        ((UITextLine*)update->widget)->updateText();
+        break;
+      case SetVisibleWidget:
+        ((UICards*)update->widget)->setVisibleWidget(update->value.visible);
+        break;
+      case SetFrame:
+        ((UISprite*)update->widget)->setFrame(update->value.index);
+        break;
+      case InvalidateLayout:
+        update->widget->invalidateLayout();
+        break;
+    }
+    __atomic_store_n(&tail,(uint8_t)(tail+1),__ATOMIC_RELEASE);
+  }
+}
+
+UIUpdateQueue::Update* UIUpdateQueue::reserve() {
+  if ((uint8_t)(head-__atomic_load_n(&tail,__ATOMIC_ACQUIRE))>=UIUIUI_UPDATE_QUEUE_SIZE)
+    return nullptr;
+  return &updates[head%UIUIUI_UPDATE_QUEUE_SIZE];
+}
+
+void UIUpdateQueue::setRenderWorker(UIRenderWorker* worker) {
+  for (UIUpdateQueue* queue=this;queue;queue=queue->next)
+    queue->renderWorker=worker;
+}
+
+void UIUpdateQueue::publish() {
+  __atomic_store_n(&head,(uint8_t)(head+1),__ATOMIC_RELEASE);
+  if (renderWorker)
+    renderWorker->wake();
+}
+
+// end of file
@@ -0,0 +1,147 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// (C) 2023 Dirk Hillbrecht
+
+#pragma once
+
+#include "Arduino.h"
+
+#include "UIConfig.h"
+
+class UIWidget;
+class UITextLine;
+class UICards;
+class UISprite;
+class UIRenderWorker;
+
+/** Queue of widget updates from interrupts or other tasks.
+ *
+ * Methods like UITextLine::setText() change the widget and signal the need for rendering
+ * up to UIDisplay. This must not happen while UIDisplay::render() runs, e.g. if an interrupt
+ * or a task on another core updates the interface. Instead of protecting the whole interface
+ * with a mutex, such code can post its updates into a queue:
+ *
+ *     UIUpdateQueue updates;
+ *     ...
+ *     display.setUpdateQueue(&updates);
+ *     ...
+ *     updates.setText(&temperatureLine,temperatureText);  // in the interrupt or task
+ *
+ * UIDisplay::render() applies all posted updates at its beginning, in its own context.
+ *
+ * The queue is lock-free for exactly one producer and one consumer (the rendering task).
+ * If several tasks or interrupts post updates, each gets its own queue. The queues are chained
+ * like widgets and the first one is given to UIDisplay:
+ *
+ *     UIUpdateQueue sensorUpdates;
+ *     UIUpdateQueue networkUpdates(&sensorUpdates);
+ *     ...
+ *     display.setUpdateQueue(&networkUpdates);
+ *
+ * Its capacity is set by UIUIUI_UPDATE_QUEUE_SIZE in UIConfig.h.
+ *
+ * setText() does not copy the text: The line reads it on every rendering, so the buffer must not be
+ * changed after posting. A producer which writes its text into the same buffer again and again
+ * uses copyText() instead. It copies the text into the queue, and applying the update copies it on
+ * into a buffer which is only accessed by the rendering task.
+ */
+class UIUpdateQueue final {
+
+  public:
+
+    /** Create an empty update queue, optionally followed by the queue of another producer. */
+    UIUpdateQueue(UIUpdateQueue* next=nullptr);
+
+    /** Post setting the text of a text line, return false if the queue is full.
+     *
+     * The text is not copied and must not change anymore, see copyText() for reused buffers.
+     */
+    bool setText(UITextLine* line,const char* text);
+
+#if UIUIUI_UPDATE_QUEUE_TEXT_SIZE>0
+    /** Post a copy of the given text for a text line, return false if the queue is full.
+     *
+     * The text is copied into the queue, so the producer may change its buffer right after posting.
+     * On applying, it is copied into the given buffer which becomes the text of the line.
+     * That buffer must have room for UIUIUI_UPDATE_QUEUE_TEXT_SIZE characters and
+     * must not be accessed by anything but the rendering task. Longer texts are cut.
+     */
+    bool copyText(UITextLine* line,char* buffer,const char* text);
+#endif
+
+    /** Post rendering the current text of a text line anew, return false if the queue is full.
+     *
+     * This is UITextLine::updateText() for a buffer which is changed in place.
+     * The buffer is read while rendering, so the producer must not change it until the line is shown.
+     */
+    bool updateText(UITextLine* line);
+
+    /** Post setting the visible widget of some cards, return false if the queue is full. */
+    bool setVisibleWidget(UICards* cards,UIWidget* visible);
+
+    /** Post setting the frame of a sprite, return false if the queue is full. */
+    bool setFrame(UISprite* sprite,uint8_t index);
+
+    /** Post invalidating the layout of a widget, return false if the queue is full. */
+    bool invalidateLayout(UIWidget* widget);
+
+    /** Return whether there are no updates waiting to be applied in this and all following queues. */
+    bool isEmpty();
+
+    /** Apply all posted updates of this and all following queues, only to be called by the rendering task. */
+    void apply();
+
+    /** Wake the given render worker whenever an update is posted into this or a following queue, set by UIDisplay. */
+    void setRenderWorker(UIRenderWorker* worker);
+
+  private:
+
+    /** Kind of an update */
+    enum Type : uint8_t { SetText,CopyText,UpdateText,SetVisibleWidget,SetFrame,InvalidateLayout };
+
+    /** One posted update */
+    struct Update {
+      Type type;
+      UIWidget* widget;
+      union {
+        const char* text;
+        UIWidget* visible;
+        uint8_t index;
+#if UIUIUI_UPDATE_QUEUE_TEXT_SIZE>0
+        struct {
+          char* buffer;
+          char text[UIUIUI_UPDATE_QUEUE_TEXT_SIZE];
+        } copy;
+#endif
+      } value;
+    };
+
+    static_assert(UIUIUI_UPDATE_QUEUE_SIZE>0 && UIUIUI_UPDATE_QUEUE_SIZE<=128 &&
+        (UIUIUI_UPDATE_QUEUE_SIZE&(UIUIUI_UPDATE_QUEUE_SIZE-1))==0,"UIUIUI_UPDATE_QUEUE_SIZE must be a power of 2 up to 128");
+
+    /** The posted updates, a ring buffer */
+    Update updates[UIUIUI_UPDATE_QUEUE_SIZE];
+
+    /** Number of posted updates ever, modulo 256, only written by the producer */
+    uint8_t head;
+
+    /** Number of applied updates ever, modulo 256, only written by the consumer */
+    uint8_t tail;
+
+    /** Render worker to wake on posting, nullptr if there is none */
+    UIRenderWorker* renderWorker;
+
+    /** Queue of the next producer, nullptr if there is none */
+    UIUpdateQueue* next;
+
+    /** Apply the posted updates of this queue only. */
+    void applyOwn();
+
+    /** Reserve the next free update, nullptr if the queue is full. */
+    Update* reserve();
+
+    /** Make the reserved update visible to the consumer. */
+    void publish();
+
+};
+
+// end of file
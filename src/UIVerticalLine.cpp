@@ -10,7 +10,7 @@
 
 /* Create a vertical line with an empty border on left and right (defaults to 0),
  * a line width (defaults to 1) and an optional successor. */
-UIVerticalLine::UIVerticalLine(uint16_t border,uint16_t lineWidth,UIWidget* next):
+UIVerticalLine::UIVerticalLine(UICoordinate border,UICoordinate lineWidth,UIWidget* next):
   UIWidget(next),border(border) {}
 
 /* Create a vertical line of width 1 with no border on left and right. */
@@ -22,7 +22,7 @@ UIArea* UIVerticalLine::render(U8G2 *display,bool force) {
     clip(display);
     clearFull(display);
     display->setDrawColor(1);
-    uint16_t x=(dim.left+dim.right)/2; // cannot overflow due to MAX_LEN
+    UICoordinate x=(dim.left+dim.right)/2; // computed in int, cannot overflow
     display->drawLine(x,dim.top,x,dim.bottom);
     return &dim;
   }
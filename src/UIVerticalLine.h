@@ -18,7 +18,7 @@ class UIVerticalLine : public UIWidget {
      *
      * Defaults are set to an empty border on left and right (default 0),
      * a line width (defaults to 1) and an optional successor. */
-    UIVerticalLine(uint16_t border=0,uint16_t lineWidth=1,UIWidget* next=nullptr);
+    UIVerticalLine(UICoordinate border=0,UICoordinate lineWidth=1,UIWidget* next=nullptr);
 
     /** Create a vertical line of width 1 with no border on left and right. */
     UIVerticalLine(UIWidget* next);
@@ -34,10 +34,7 @@ class UIVerticalLine : public UIWidget {
   private:
 
     /** Width of the border. */
-    uint16_t border;
-
-    /** Width of the line. */
-    uint16_t lineWidth;
+    UICoordinate border;
 
 };
 
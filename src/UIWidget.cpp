@@ -4,14 +4,19 @@
 #include "Arduino.h"
 #include <U8g2lib.h>
 
+#include "UIConfig.h"
 #include "UIEnums.h"
 #include "UISize.h"
 #include "UIArea.h"
+#include "UIAreaList.h"
+#include "UIFrameBuffer.h"
+#include "UIStatistics.h"
 #include "UIWidget.h"
 #include "UIParent.h"
 
 
-UIWidget::UIWidget(UIWidget *next): dim(),thePreferredSize(),next(next),parent(nullptr) {}
+UIWidget::UIWidget(UIWidget *next): dim(),thePreferredSize(),next(next),parent(nullptr),
+  layoutPending(false),preferredSizeInvalid(false),layoutMoved(false),layoutRender(false) {}
 
 UISize UIWidget::preferredSize(U8G2* display) {
   if (thePreferredSize.isEmpty())
@@ -20,18 +25,106 @@ UISize UIWidget::preferredSize(U8G2* display) {
 }
 
 void UIWidget::layout(U8G2* display,UIArea* dim) {
+  layoutMoved=!this->dim.equals(dim);
+  layoutPending=false;
   this->dim.set(dim);
 }
 
+void UIWidget::invalidateLayout() {
+  preferredSizeInvalid=true;
+  signalNeedsLayout();
+  signalNeedsRendering();
+}
+
+bool UIWidget::refreshPreferredSize(U8G2* display) {
+  if (!layoutPending)
+    return false;
+  bool childrenChanged=refreshChildrenSizes(display);
+  if (!preferredSizeInvalid && !childrenChanged)
+    return false;
+  preferredSizeInvalid=false;
+  UISize former=thePreferredSize;
+  thePreferredSize.set(0,0);
+  computePreferredSize(display,&thePreferredSize);
+  return thePreferredSize.width!=former.width || thePreferredSize.height!=former.height;
+}
+
+bool UIWidget::refreshChildrenSizes(U8G2* display) {
+  return false;
+}
+
+void UIWidget::signalNeedsLayout() {
+  if (!layoutPending) {
+    layoutPending=true;
+    if (parent)
+      parent->childNeedsLayout(this);
+  }
+}
+
+void UIWidget::layoutChild(U8G2* display,UIWidget* child,UIArea* area) {
+  if (child->dim.equals(area) && !child->layoutPending)
+    return;
+  // If this widget stays where it is but a child moves, this widget is rendered completely
+  if (!layoutMoved && !child->dim.equals(area)) {
+    layoutRender=true;
+    signalNeedsRendering();
+  }
+  child->layout(display,area);
+}
+
+void UIWidget::renderAreas(U8G2* display,bool force,UIAreaList* rendered) {
+  if (force) {  // With a page buffer, widgets outside the current page need not be drawn at all
+    u8g2_t *u8g2=display->getU8g2();
+    if (dim.right<=u8g2->user_x0 || dim.left>=u8g2->user_x1 || dim.bottom<=u8g2->user_y0 || dim.top>=u8g2->user_y1)
+      return;
+  }
+  if (layoutRender) {  // Children have moved: Clear everything and render it anew
+    layoutRender=false;
+    clip(display);
+    clearFull(display);
+    rendered->add(&dim);
+    force=true;
+  }
+#if UIUIUI_STATISTICS
+  uint32_t start=micros();
+  doRenderAreas(display,force,rendered);
+  uint32_t duration=micros()-start;
+  statistics.renderCalls++;
+  statistics.renderMicros+=duration;
+  if (duration>statistics.maxRenderMicros)
+    statistics.maxRenderMicros=duration;
+#else
+  doRenderAreas(display,force,rendered);
+#endif
+}
+
+void UIWidget::doRenderAreas(U8G2* display,bool force,UIAreaList* rendered) {
+  addRendered(rendered,render(display,force));
+}
+
+void UIWidget::addRendered(UIAreaList* rendered,UIArea* area) {
+#if UIUIUI_STATISTICS
+  if (area->hasArea()) {
+    statistics.renderedAreas++;
+    statistics.renderedPixels+=(uint32_t)(area->right-area->left)*(uint32_t)(area->bottom-area->top);
+  }
+#endif
+  rendered->add(area);
+}
+
 void UIWidget::clearBox(U8G2* display,UIArea *dimm) {
-  display->setDrawColor(0);
-  display->drawBox(dimm->left,dimm->top,(dimm->right-dimm->left),(dimm->bottom-dimm->top));
+  UIFrameBuffer::clear(display,dimm);
 }
 
 void UIWidget::clearFull(U8G2 *display) {
   clearBox(display,&dim);
 }
 
+bool UIWidget::isWithinPage(U8G2 *display) {
+  u8g2_t *u8g2=display->getU8g2();
+  return dim.left>=u8g2->user_x0 && dim.right<=u8g2->user_x1 && dim.top>=u8g2->user_y0 && dim.bottom<=u8g2->user_y1;
+}
+
 void UIWidget::clip(U8G2 *display) {
   display->setClipWindow(dim.left,dim.top,dim.right,dim.bottom);
 }
@@ -45,4 +138,15 @@ void UIWidget::signalNeedsRendering() {
     parent->childNeedsRendering(this);
 }
 
+void UIWidget::signalDefersRendering(UIArea* area,uint16_t millis) {
+  if (parent)
+    parent->childDefersRendering(this,area,millis);
+}
+
+#if UIUIUI_STATISTICS
+UIWidgetStatistics* UIWidget::getStatistics() {
+  return &statistics;
+}
+#endif
+
 // end of file
@@ -6,9 +6,12 @@
 #include "Arduino.h"
 #include <U8g2lib.h>
 
+#include "UIConfig.h"
 #include "UIEnums.h"
 #include "UISize.h"
 #include "UIArea.h"
+#include "UIAreaList.h"
+#include "UIStatistics.h"
 //#include "UIParent.h"
 
 // Forward reference
@@ -50,6 +53,25 @@ class UIWidget {
      */
     virtual void layout(U8G2* display,UIArea* area);
 
+    /** Compute the preferred size again if it might have changed due to invalidateLayout(), called by UIDisplay.
+     *
+     * Only widgets on the path to a widget with invalidated layout are visited. The preferred size
+     * of a widget is only computed again if its own layout has been invalidated or if the preferred size
+     * of one of its children has changed, so the computation stops as soon as a size stays the same.
+     *
+     * @return true if the preferred size of this widget has changed.
+     */
+    bool refreshPreferredSize(U8G2* display);
+
+    /** Signal that the preferred size or the inner layout of this widget has changed.
+     *
+     * The preferred size is computed again and the widget tree is layouted again
+     * during the next UIDisplay::render() call. Only widgets whose area actually changes
+     * and the widgets on the path up to the display are layouted again. The smallest
+     * widget group containing all moved widgets is cleared and rendered completely.
+     */
+    void invalidateLayout();
+
     /** Render component in the space given in layout().
      *
      * If force is true, the component must render itself in its rectangle.
@@ -61,6 +83,18 @@ class UIWidget {
      */
     virtual UIArea* render(U8G2* display,bool force)=0;
 
+    /** Render component and add the areas which actually must be written to screen to the given list.
+     *
+     * This is the variant of render() used by UIDisplay. It allows widget groups to report
+     * the changed areas of their children separately instead of uniting them into one
+     * enclosing area which might be much larger than the actual changes.
+     *
+     * This method delegates the operation into doRenderAreas()
+     * and collects the render statistics if they are enabled.
+     * Forced rendering is skipped if the widget is completely outside the current page of a page buffer.
+     */
+    void renderAreas(U8G2* display,bool force,UIAreaList* rendered);
+
     /** Pointer to the next widget on the same level. */
     UIWidget *next;
 
@@ -71,6 +105,11 @@ class UIWidget {
      */
     virtual void setParent(UIParent *parent);
 
+#if UIUIUI_STATISTICS
+    /** Return the render statistics of this widget. */
+    UIWidgetStatistics* getStatistics();
+#endif
+
   protected:
 
     /** Initialize this widget and potentially set its successor. */
@@ -88,9 +127,33 @@ class UIWidget {
     /** Clear the full area of this widget. */
     void clearFull(U8G2 *display);
 
+    /** Return whether this widget lies completely within the current page, always true with a full frame buffer.
+     *
+     * Forced rendering of a page buffer draws only the parts of widgets on the current page.
+     * Widget groups keep the pending changes of their children then, unless the group is drawn completely.
+     */
+    bool isWithinPage(U8G2 *display);
+
     /** Set U8g2's clip window to the area of this widget, should be called from render(). */
     void clip(U8G2 *display);
 
+    /** Layout a child widget in the given area, should be called from layout() of widgets with children.
+     *
+     * The child is only layouted if its area changes or if it has signalled a layout change.
+     * If this widget itself keeps its area, it is cleared and rendered completely
+     * the next time if the area of the child changes.
+     */
+    void layoutChild(U8G2* display,UIWidget* child,UIArea* area);
+
+    /** Signal a needed layout to the parent, should be called by childNeedsLayout(). */
+    void signalNeedsLayout();
+
+    /** Call refreshPreferredSize() for all children with pending layout, return whether one of their sizes has changed.
+     *
+     * Widgets with children must override this, the default implementation has no children and returns false.
+     */
+    virtual bool refreshChildrenSizes(U8G2* display);
+
     /** Store preferred size of this widget into the preferredSize reference.
      *
      * Implementations can be assured to be called only once and the passed preferredSize will be (0,0).
@@ -100,11 +163,42 @@ class UIWidget {
     /** Called internally: Signals to parent that this widget needs to be rendered. */
     void signalNeedsRendering();
 
+    /** Called internally: Signals to parent that the given area of this widget wants to be rendered after the given time. */
+    void signalDefersRendering(UIArea* area,uint16_t millis);
+
+    /** Render component and add the areas which actually must be written to screen to the given list.
+     *
+     * The default implementation calls render() and adds its result to the list.
+     * Widgets which group other widgets should override this method and pass the list
+     * down to their children by calling their renderAreas() methods.
+     */
+    virtual void doRenderAreas(U8G2* display,bool force,UIAreaList* rendered);
+
+    /** Add an area rendered by this widget to the list, should be called from doRenderAreas(). */
+    void addRendered(UIAreaList* rendered,UIArea* area);
+
   private:
 
     /** Preferred size of this widget, stored as it might be needed several time, e.g. in layout(). */
     UISize thePreferredSize;
 
+    /** Flag whether this widget or one of its children has signalled a layout change. */
+    bool layoutPending:1;
+
+    /** Flag whether the preferred size of this widget must be computed again due to invalidateLayout(). */
+    bool preferredSizeInvalid:1;
+
+    /** Flag whether the area of this widget has changed in the last call to layout(). */
+    bool layoutMoved:1;
+
+    /** Flag whether this widget must be cleared and rendered completely due to a layout change. */
+    bool layoutRender:1;
+
+#if UIUIUI_STATISTICS
+    /** Render statistics of this widget. */
+    UIWidgetStatistics statistics;
+#endif
+
 };
 
 // end of file
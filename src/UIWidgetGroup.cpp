@@ -5,12 +5,13 @@
 #include <U8g2lib.h>
 
 #include "UIArea.h"
+#include "UIAreaList.h"
 #include "UIWidget.h"
 #include "UIWidgetGroup.h"
 
 /* Create a widget group with a linked list of sub-widgets and a potential successor. */
 UIWidgetGroup::UIWidgetGroup(UIWidget* firstChild,UIWidget* next):
-UIWidget(next), firstChild(firstChild), rendered(), renderChildren(false) {
+UIWidget(next), firstChild(firstChild), rendered(), dirtyChildren(0) {
   UIWidget* elem=firstChild;
   while (elem) {
     elem->setParent(this);
@@ -21,23 +22,72 @@ UIWidget(next), firstChild(firstChild), rendered(), renderChildren(false) {
 /* Default implementation of rendering a widget group is to render all of its sub-widgets. */
 UIArea* UIWidgetGroup::render(U8G2* display,bool force) {
   rendered.set(0,0,0,0);
-  if (force || renderChildren) {
+  if (force || dirtyChildren) {
+    uint16_t dirty=(force?0xffff:dirtyChildren);
+    dirtyChildren=0;  // cleared before, so that children deferring their rendering stay dirty
+    uint16_t bit=1;
     UIWidget* elem=firstChild;
     while (elem) {
-      rendered.uniteWith(elem->render(display,force));
+      if (dirty&bit)
+        rendered.uniteWith(elem->render(display,force));
       elem=elem->next;
+      if (bit<0x8000)
+        bit<<=1;
     }
-    renderChildren=false;
   }
   return &rendered;
 }
 
+/* Default implementation of rendering a widget group is to render all of its sub-widgets, collecting their areas separately. */
+void UIWidgetGroup::doRenderAreas(U8G2* display,bool force,UIAreaList* rendered) {
+  if (force || dirtyChildren) {
+    uint16_t dirty=(force?0xffff:dirtyChildren);
+    if (!force || isWithinPage(display))  // forced page rendering skips children outside the page, they keep their changes
+      dirtyChildren=0;  // cleared before, so that children deferring their rendering stay dirty
+    uint16_t bit=1;
+    UIWidget* elem=firstChild;
+    while (elem) {
+      if (dirty&bit)
+        elem->renderAreas(display,force,rendered);
+      elem=elem->next;
+      if (bit<0x8000)
+        bit<<=1;
+    }
+  }
+}
+
 /** Called by any child of this group to indicate that it wants to be rendered. */
 void UIWidgetGroup::childNeedsRendering(UIWidget *child) {
-  if (!renderChildren) {
-    renderChildren=true;
-    signalNeedsRendering();
-  }
+  dirtyChildren|=childBit(child);
+  // Always passed on: Children deferring their rendering stay dirty after a rendering, so the bits do not tell whether the parent knows
+  signalNeedsRendering();
+}
+
+/* Walk through the children up to the given one, the highest bit is shared by all children from the 16th on. */
+uint16_t UIWidgetGroup::childBit(UIWidget* child) {
+  uint16_t bit=1;
+  for (UIWidget* elem=firstChild;elem && elem!=child && bit<0x8000;elem=elem->next)
+    bit<<=1;
+  return bit;
+}
+
+/* All children are visited, as the preferred sizes of all of them may contribute to the group's size. */
+bool UIWidgetGroup::refreshChildrenSizes(U8G2* display) {
+  bool changed=false;
+  for (UIWidget* elem=firstChild;elem;elem=elem->next)
+    changed|=elem->refreshPreferredSize(display);
+  return changed;
+}
+
+/** Called by any child of this group to indicate that its layout has changed. */
+void UIWidgetGroup::childNeedsLayout(UIWidget *child) {
+  signalNeedsLayout();
+}
+
+/** Called by any child of this group which wants to be rendered after the given time. */
+void UIWidgetGroup::childDefersRendering(UIWidget *child,UIArea *area,uint16_t millis) {
+  dirtyChildren|=childBit(child);
+  signalDefersRendering(area,millis);
 }
 
 // end of file
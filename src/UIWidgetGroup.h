@@ -7,6 +7,7 @@
 #include <U8g2lib.h>
 
 #include "UIArea.h"
+#include "UIAreaList.h"
 #include "UIWidget.h"
 #include "UIParent.h"
 
@@ -36,19 +37,43 @@ class UIWidgetGroup: public UIWidget, public UIParent {
     /** Default implementation of rendering a widget group is to render all of its sub-widgets. */
     UIArea* render(U8G2* display,bool force);
 
-    /** Called by any child of this group to indicate that it wants to be rendered. */
+    /** Called by any child of this group to indicate that it wants to be rendered.
+     *
+     * Always passed on to the parent, also if the child is already known as dirty. A child below a parent
+     * which handles held back changes with the default of UIParent::childDefersRendering() wakes the display
+     * with each render() call this way until its time has come.
+     */
     virtual void childNeedsRendering(UIWidget *child);
 
+    /** Called by any child of this group to indicate that its layout has changed. */
+    void childNeedsLayout(UIWidget *child);
+
+    /** Called by any child of this group which wants to be rendered after the given time. */
+    void childDefersRendering(UIWidget *child,UIArea *area,uint16_t millis);
+
   protected:
 
+    /** Refresh the preferred sizes of all children with pending layout. */
+    bool refreshChildrenSizes(U8G2* display);
+
+    /** Default implementation of rendering a widget group is to render all of its sub-widgets, collecting their areas separately. */
+    void doRenderAreas(U8G2* display,bool force,UIAreaList* rendered);
+
     /** The first of the widgets grouped by this widget group. */
     UIWidget* firstChild;
 
-    /** Flag whether any child of this group needs to be rendered. */
-    bool renderChildren;
+    /** Bit mask of the children of this group which need to be rendered.
+     *
+     * Bit i stands for the i-th child, the highest bit for the 16th and all further children.
+     * Non-forced rendering calls only the children whose bit is set.
+     */
+    uint16_t dirtyChildren;
     // Note: This is protected as UICards handles this on its own.
     // With a better abstraction, this could be made private.
 
+    /** Return the bit of the given child in dirtyChildren. */
+    uint16_t childBit(UIWidget* child);
+
   private:
 
     /** Space where the rendering information of all sub-widgets is collected. */
@@ -22,13 +22,18 @@
  */
 
 // Basic helper classes and definitions
+#include "UIConfig.h"
+#include "UIFootprint.h"
 #include "UIEnums.h"
 #include "UIPoint.h"
 #include "UISize.h"
 #include "UIArea.h"
+#include "UIAreaList.h"
+#include "UIFrameBuffer.h"
 
 // Simple widgets
 #include "UIWidget.h"
+#include "UITextWidthCache.h"
 #include "UITextLine.h"
 #include "UITextIcon.h"
 #include "UIHorizontalLine.h"
@@ -36,12 +41,24 @@
 #include "UICheckerboard.h"
 #include "UIEnvelope.h"
 #include "UIBitmap.h"
+#include "UIFlashBitmap.h"
+#include "UISprite.h"
 
 // Widget groups
 #include "UIWidgetGroup.h"
 #include "UIRows.h"
 #include "UIColumns.h"
 #include "UICards.h"
+#include "UIStaticLengths.h"
+#include "UIStaticRows.h"
+#include "UIStaticColumns.h"
 
 // Topmost class
+#include "UIStatistics.h"
+#include "UITransfer.h"
+#include "UIUpdateQueue.h"
+#include "UIRenderWorker.h"
+#include "UIThreadRenderWorker.h"
+#include "UIFreeRTOSRenderWorker.h"
+#include "UISimulatedTransfer.h"
 #include "UIDisplay.h"